@@ -1,4 +1,4 @@
-QT       += core gui
+QT       += core gui concurrent
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -15,9 +15,30 @@ SOURCES += \
     applicationlog/applicationlog.cpp \
     applicationlog/debuglog.cpp \
     applicationlog/logdata.cpp \
+    filehash/blake3.cpp \
+    filehash/crc32c.cpp \
+    filehash/duplicatefinder.cpp \
+    filehash/filehashalgorithm.cpp \
+    filehash/filehashcache.cpp \
+    filehash/filehashcalculator.cpp \
+    filehash/filehasher.cpp \
+    filehash/filehashservice.cpp \
+    filehash/filehashstatistics.cpp \
+    filehash/filereader.cpp \
+    filehash/uringbatchreader.cpp \
+    filehash/xxhash64.cpp \
     filenamevalidator.cpp \
     htmltextdelegate.cpp \
+    imagehash/exifthumbnail.cpp \
+    imagehash/imageclusterfinder.cpp \
+    imagehash/imagehashalgorithm.cpp \
     imagehash/imagehashcalculator.cpp \
+    imagehash/imagehashservice.cpp \
+    imagehash/imageheader.cpp \
+    imagehash/jpegsegmentreader.cpp \
+    imagehash/multiindexhash.cpp \
+    path/dirhandle.cpp \
+    path/inodegroups.cpp \
     path/parentdir.cpp \
     path/pathentity.cpp \
     path/pathentityinfo.cpp \
@@ -26,25 +47,34 @@ SOURCES += \
     path/pathroot.cpp \
     path/pathtableview.cpp \
     path/pathtableviewmenu.cpp \
+    path/renameplanner.cpp \
     pathsanalyzer.cpp \
     renamestate/renamestateinitial.cpp \
     savedsettingsmodel.cpp \
     searchindirs.cpp \
     stringbuilder/abstractinsertstring.cpp \
+    stringbuilder/ahocorasick.cpp \
     stringbuilder/builderchain.cpp \
     stringbuilder/insertstring.cpp \
     stringbuilder/number.cpp \
     stringbuilder/onfile/builderchainonfile.cpp \
     stringbuilder/onfile/cryptographichash.cpp \
+    stringbuilder/onfile/duplicategroup.cpp \
+    stringbuilder/onfile/imagedimensions.cpp \
+    stringbuilder/onfile/imagegroup.cpp \
     stringbuilder/onfile/imagehash.cpp \
     stringbuilder/onfile/originalname.cpp \
     stringbuilder/replacestring.cpp \
+    stringbuilder/replacetable.cpp \
     stringbuilder/stringbuilderchainmodel.cpp \
     stringbuilder/stringbuilderfactory.cpp \
     stringbuilder/stringbuildersmodel.cpp \
     stringbuilder/widgets/abstractstringbuilderwidget.cpp \
     stringbuilder/widgets/dialogbuildersettings.cpp \
+    stringbuilder/widgets/widgetduplicategroupsetting.cpp \
     stringbuilder/widgets/widgetfilehashsetting.cpp \
+    stringbuilder/widgets/widgetimagedimensionssetting.cpp \
+    stringbuilder/widgets/widgetimagegroupsetting.cpp \
     stringbuilder/widgets/widgetimagehashsetting.cpp \
     stringbuilder/widgets/widgetinserttextsetting.cpp \
     stringbuilder/widgets/widgetnumbersetting.cpp \
@@ -52,6 +82,7 @@ SOURCES += \
     stringbuilder/widgets/widgetoriginalnamesetting.cpp \
     stringbuilder/widgets/widgetpositionfixer.cpp \
     stringbuilder/widgets/widgetreplacesetting.cpp \
+    stringbuilder/widgets/widgetreplacetablesetting.cpp \
     threadcreatenewnames.cpp \
     threadrename.cpp \
     threadundorenaming.cpp \
@@ -66,6 +97,7 @@ SOURCES += \
     widgets/framebuilderlist.cpp \
     widgets/historycombobox.cpp \
     widgets/widgetapplicationlogs.cpp \
+    widgets/widgethashstatistics.cpp \
     widgets/widgetloadsavebuildersettings.cpp
 
 HEADERS += \
@@ -73,11 +105,33 @@ HEADERS += \
     applicationlog/applicationlog.h \
     applicationlog/debuglog.h \
     applicationlog/logdata.h \
+    filehash/blake3.h \
+    filehash/filedigest.h \
+    filehash/crc32c.h \
+    filehash/duplicatefinder.h \
+    filehash/filehashalgorithm.h \
+    filehash/filehashcache.h \
+    filehash/filehashcalculator.h \
+    filehash/filehasher.h \
+    filehash/filehashservice.h \
+    filehash/filehashstatistics.h \
+    filehash/filereader.h \
+    filehash/uringbatchreader.h \
+    filehash/xxhash64.h \
     filenamevalidator.h \
     genericactions.h \
     htmltextdelegate.h \
+    imagehash/exifthumbnail.h \
+    imagehash/imageclusterfinder.h \
+    imagehash/imagehashalgorithm.h \
     imagehash/imagehashcalculator.h \
+    imagehash/imagehashservice.h \
+    imagehash/imageheader.h \
+    imagehash/jpegsegmentreader.h \
+    imagehash/multiindexhash.h \
     mainwindow.h \
+    path/dirhandle.h \
+    path/inodegroups.h \
     path/parentdir.h \
     path/pathentity.h \
     path/pathentityinfo.h \
@@ -86,6 +140,7 @@ HEADERS += \
     path/pathroot.h \
     path/pathtableview.h \
     path/pathtableviewmenu.h \
+    path/renameplanner.h \
     path/usingpathentity.h \
     pathsanalyzer.h \
     renamestate/renamestateistate.h \
@@ -94,6 +149,7 @@ HEADERS += \
     searchindirs.h \
     stringbuilder/abstractinsertstring.h \
     stringbuilder/abstractstringbuilder.h \
+    stringbuilder/ahocorasick.h \
     stringbuilder/builderchain.h \
     stringbuilder/buildertypes.h \
     stringbuilder/insertstring.h \
@@ -101,16 +157,23 @@ HEADERS += \
     stringbuilder/onfile/abstractneedfileinfo.h \
     stringbuilder/onfile/builderchainonfile.h \
     stringbuilder/onfile/cryptographichash.h \
+    stringbuilder/onfile/duplicategroup.h \
     stringbuilder/onfile/ifileinfo.h \
+    stringbuilder/onfile/imagedimensions.h \
+    stringbuilder/onfile/imagegroup.h \
     stringbuilder/onfile/imagehash.h \
     stringbuilder/onfile/originalname.h \
     stringbuilder/replacestring.h \
+    stringbuilder/replacetable.h \
     stringbuilder/stringbuilderchainmodel.h \
     stringbuilder/stringbuilderfactory.h \
     stringbuilder/stringbuildersmodel.h \
     stringbuilder/widgets/abstractstringbuilderwidget.h \
     stringbuilder/widgets/dialogbuildersettings.h \
+    stringbuilder/widgets/widgetduplicategroupsetting.h \
     stringbuilder/widgets/widgetfilehashsetting.h \
+    stringbuilder/widgets/widgetimagedimensionssetting.h \
+    stringbuilder/widgets/widgetimagegroupsetting.h \
     stringbuilder/widgets/widgetimagehashsetting.h \
     stringbuilder/widgets/widgetinserttextsetting.h \
     stringbuilder/widgets/widgetnumbersetting.h \
@@ -118,11 +181,13 @@ HEADERS += \
     stringbuilder/widgets/widgetoriginalnamesetting.h \
     stringbuilder/widgets/widgetpositionfixer.h \
     stringbuilder/widgets/widgetreplacesetting.h \
+    stringbuilder/widgets/widgetreplacetablesetting.h \
     threadcreatenewnames.h \
     threadrename.h \
     threadundorenaming.h \
     usingstringbuilder.h \
     usingstringbuilderwidget.h \
+    utilitysformat.h \
     utilityshtml.h \
     utilitysmvc.h \
     widgets/comboboxselectionkeeper.h \
@@ -133,21 +198,28 @@ HEADERS += \
     widgets/framebuilderlist.h \
     widgets/historycombobox.h \
     widgets/widgetapplicationlogs.h \
+    widgets/widgethashstatistics.h \
     widgets/widgetloadsavebuildersettings.h
 
 FORMS += \
     mainwindow.ui \
     stringbuilder/widgets/dialogbuildersettings.ui \
+    stringbuilder/widgets/widgetduplicategroupsetting.ui \
     stringbuilder/widgets/widgetfilehashsetting.ui \
+    stringbuilder/widgets/widgetimagedimensionssetting.ui \
+    stringbuilder/widgets/widgetimagegroupsetting.ui \
+    stringbuilder/widgets/widgetimagehashsetting.ui \
     stringbuilder/widgets/widgetinserttextsetting.ui \
     stringbuilder/widgets/widgetnumbersetting.ui \
     stringbuilder/widgets/widgetonlypositionfixer.ui \
     stringbuilder/widgets/widgetpositionfixer.ui \
     stringbuilder/widgets/widgetreplacesetting.ui \
+    stringbuilder/widgets/widgetreplacetablesetting.ui \
     widgets/dialogdroppeddir.ui \
     widgets/dialogsettingslistconfigurator.ui \
     widgets/framebuilderlist.ui \
     widgets/widgetapplicationlogs.ui \
+    widgets/widgethashstatistics.ui \
     widgets/widgetloadsavebuildersettings.ui
 
 # Default rules for deployment.
@@ -23,10 +23,12 @@
 #include <QDateTime>
 #include <QDir>
 #include <QFile>
+#include <QMutex>
 #include <QDebug>
 
 namespace {
 Q_GLOBAL_STATIC(QReadWriteLock, rwlock)
+Q_GLOBAL_STATIC(QMutex, appendMutex) // one row insertion at a time, from any thread
 Q_GLOBAL_STATIC(ApplicationLog, appLog)
 
 QString logDirPath()
@@ -124,6 +126,8 @@ bool ApplicationLog::isEmpty() const
 
 void ApplicationLog::log(QStringView log, QStringView groupName)
 {
+    QMutexLocker locker(appendMutex);
+
     rwlock->lockForRead();
     int row = int(m_applicationLogs.size());
     rwlock->unlock();
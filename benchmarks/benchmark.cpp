@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "benchmark.h"
+
+#include <QFile>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace Benchmark {
+
+void evict(const QString &filePath)
+{
+#if defined(Q_OS_UNIX) && defined(POSIX_FADV_DONTNEED)
+    const int fd = ::open(QFile::encodeName(filePath).constData(), O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1)
+        return;
+
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd);
+#else
+    Q_UNUSED(filePath)
+#endif
+}
+
+qint64 peakMemoryKiB()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+
+    if (::getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+#ifdef Q_OS_DARWIN
+    return qint64(usage.ru_maxrss) / 1024; // bytes there
+#else
+    return qint64(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
+
+} // Benchmark
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace Benchmark {
+
+// the median of repeatCount runs of body, in seconds. prepare runs untimed before each.
+template <typename Prepare, typename Body>
+double medianSeconds(int repeatCount, const Prepare &prepare, const Body &body)
+{
+    std::vector<qint64> times;
+
+    for (int i = 0; i < repeatCount; ++i) {
+        prepare();
+
+        QElapsedTimer timer;
+
+        timer.start();
+        body();
+        times.push_back(timer.nsecsElapsed());
+    }
+
+    const auto middle = times.begin() + qsizetype(times.size() / 2);
+
+    std::nth_element(times.begin(), middle, times.end());
+
+    return double(*middle) / 1e9;
+}
+
+template <typename Body>
+double medianSeconds(int repeatCount, const Body &body)
+{
+    return medianSeconds(repeatCount, []() {}, body);
+}
+
+// drops the file from the page cache so that the next read goes to the disk. tmpfs keeps it.
+void evict(const QString &filePath);
+
+// the peak resident memory of the process so far. 0 where it is not known.
+qint64 peakMemoryKiB();
+
+inline void printRate(const QString &label, double rate, const char *unit)
+{
+    std::printf("%-36s %12.1f %s\n", qPrintable(label), rate, unit);
+}
+
+} // Benchmark
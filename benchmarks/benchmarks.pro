@@ -0,0 +1,50 @@
+# Command line measurements of the hashing and image paths. Not part of the application.
+#   qmake benchmarks.pro && make && ./filerenamerbench
+
+QT       += core concurrent gui
+
+CONFIG += c++2a console
+CONFIG -= app_bundle
+
+TARGET = filerenamerbench
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    benchmark.cpp \
+    hashbenchmark.cpp \
+    imagebenchmark.cpp \
+    main.cpp \
+    readbenchmark.cpp \
+    replacebenchmark.cpp \
+    smallfilebenchmark.cpp \
+    ../filehash/blake3.cpp \
+    ../filehash/crc32c.cpp \
+    ../filehash/filehashalgorithm.cpp \
+    ../filehash/filehasher.cpp \
+    ../filehash/filereader.cpp \
+    ../filehash/uringbatchreader.cpp \
+    ../filehash/xxhash64.cpp \
+    ../imagehash/exifthumbnail.cpp \
+    ../imagehash/imagehashalgorithm.cpp \
+    ../imagehash/imagehashcalculator.cpp \
+    ../imagehash/jpegsegmentreader.cpp
+
+HEADERS += \
+    benchmark.h \
+    hashbenchmark.h \
+    imagebenchmark.h \
+    readbenchmark.h \
+    replacebenchmark.h \
+    smallfilebenchmark.h \
+    ../filehash/blake3.h \
+    ../filehash/crc32c.h \
+    ../filehash/filehashalgorithm.h \
+    ../filehash/filehasher.h \
+    ../filehash/filereader.h \
+    ../filehash/uringbatchreader.h \
+    ../filehash/xxhash64.h \
+    ../imagehash/exifthumbnail.h \
+    ../imagehash/imagehashalgorithm.h \
+    ../imagehash/imagehashcalculator.h \
+    ../imagehash/jpegsegmentreader.h
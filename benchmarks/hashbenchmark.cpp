@@ -0,0 +1,85 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hashbenchmark.h"
+#include "benchmark.h"
+
+#include "filehash/filehasher.h"
+
+#include <QThread>
+
+#include <cstring>
+#include <random>
+
+namespace {
+
+constexpr int repeatCount = 3;
+constexpr qsizetype updateSize = 1024 * 1024; // the buffer of FileReader
+
+} // anonymous
+
+int runHashBenchmark(int sizeInMiB)
+{
+    if (sizeInMiB <= 0) {
+        std::fprintf(stderr, "hash: the size must be positive\n");
+        return 1;
+    }
+
+    QByteArray data(qsizetype(sizeInMiB) << 20, Qt::Uninitialized);
+    std::mt19937_64 random(1);
+
+    for (qsizetype i = 0; i < data.size(); i += 8) {
+        const quint64 value = random();
+
+        std::memcpy(data.data() + i, &value, 8);
+    }
+
+    auto measure = [&data](FileHash::Algorithm algorithm, qsizetype chunkSize) {
+        const double seconds = Benchmark::medianSeconds(repeatCount, [&]() {
+            FileHasher hasher(algorithm);
+
+            for (qsizetype offset = 0; offset < data.size(); offset += chunkSize)
+                hasher.addData(QByteArrayView(data).sliced(offset, qMin(chunkSize, data.size() - offset)));
+
+            hasher.result();
+        });
+
+        return double(data.size()) / 1e9 / seconds;
+    };
+
+    using Algorithm = FileHash::Algorithm;
+
+    const Algorithm algorithms[] = {
+        Algorithm::Md5, Algorithm::Sha1, Algorithm::Sha256,
+        Algorithm::Crc32c, Algorithm::XxHash64, Algorithm::Blake3,
+    };
+
+    std::printf("%d MiB in memory, %d threads\n", sizeInMiB, QThread::idealThreadCount());
+
+    for (Algorithm algorithm : algorithms) {
+        Benchmark::printRate(FileHash::algorithmName(algorithm) + QStringLiteral(", 1 MiB updates"),
+                             measure(algorithm, updateSize), "GB/s");
+    }
+
+    // one update of the whole data takes the parallel path of BLAKE3
+    Benchmark::printRate(QStringLiteral("BLAKE3, one update"),
+                         measure(Algorithm::Blake3, data.size()), "GB/s");
+
+    return 0;
+}
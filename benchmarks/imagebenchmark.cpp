@@ -0,0 +1,80 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "imagebenchmark.h"
+#include "benchmark.h"
+
+#include "imagehash/imagehashcalculator.h"
+
+#include <QDir>
+#include <QImage>
+
+namespace {
+
+constexpr int repeatCount = 1; // a folder of camera images takes long enough
+
+} // anonymous
+
+int runImageBenchmark(const QString &dirPath)
+{
+    QStringList filePaths;
+
+    for (const QFileInfo &info : QDir(dirPath).entryInfoList(QDir::Files, QDir::Name))
+        filePaths.append(info.absoluteFilePath());
+
+    if (filePaths.isEmpty()) {
+        std::fprintf(stderr, "images: %s has no file\n", qPrintable(dirPath));
+        return 1;
+    }
+
+    using Algorithm = PerceptualHash::Algorithm;
+
+    const Algorithm algorithms[] = {
+        Algorithm::Difference, Algorithm::Average, Algorithm::Dct, Algorithm::Wavelet,
+    };
+
+    std::printf("%s, %lld files\n", qPrintable(dirPath), qint64(filePaths.size()));
+
+    // the scaled decodes first, so that the peak memory is theirs
+    for (Algorithm algorithm : algorithms) {
+        const double scaledSeconds = Benchmark::medianSeconds(repeatCount, [&]() {
+            for (const QString &filePath : filePaths)
+                ImageHashCalculator(filePath).result(algorithm);
+        });
+
+        Benchmark::printRate(PerceptualHash::algorithmName(algorithm)
+                             + QStringLiteral(", scaled decode"),
+                             double(filePaths.size()) / scaledSeconds, "images/s");
+    }
+
+    Benchmark::printRate(QStringLiteral("peak memory, scaled decode"),
+                         double(Benchmark::peakMemoryKiB()) / 1024, "MiB");
+
+    const double fullSeconds = Benchmark::medianSeconds(repeatCount, [&]() {
+        for (const QString &filePath : filePaths)
+            QImage(filePath).scaled(32, 32, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    });
+
+    Benchmark::printRate(QStringLiteral("full decode, then scaled"),
+                         double(filePaths.size()) / fullSeconds, "images/s");
+    Benchmark::printRate(QStringLiteral("peak memory, full decode"),
+                         double(Benchmark::peakMemoryKiB()) / 1024, "MiB");
+
+    return 0;
+}
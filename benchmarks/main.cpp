@@ -0,0 +1,81 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hashbenchmark.h"
+#include "imagebenchmark.h"
+#include "readbenchmark.h"
+#include "replacebenchmark.h"
+#include "smallfilebenchmark.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+
+#include <cstdio>
+
+namespace {
+
+int printUsage()
+{
+    std::fprintf(stderr,
+                 "usage: filerenamerbench <mode> [arguments]\n"
+                 "  hash [MiB]             GB/s of each hash algorithm in memory, 256 MiB\n"
+                 "                         by default\n"
+                 "  images <dir>           images/s and peak memory of the perceptual hashes\n"
+                 "  read <file>            MB/s of each FileReader strategy\n"
+                 "  replace [n]            names/s of the replace paths over n names, 1M by\n"
+                 "                         default\n"
+                 "  smallfiles <dir> [n]   files/s of the thread pool and io_uring paths\n"
+                 "                         with n reads in flight, 2 by default\n");
+
+    return 2;
+}
+
+} // anonymous
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication application(argc, argv);
+
+    const QStringList arguments = QCoreApplication::arguments().mid(1);
+
+    if (arguments.isEmpty())
+        return printUsage();
+
+    const QString &mode = arguments.first();
+
+    if (mode == QStringLiteral("hash") && arguments.size() <= 2)
+        return runHashBenchmark(arguments.value(1, QStringLiteral("256")).toInt());
+
+    if (mode == QStringLiteral("images") && arguments.size() == 2)
+        return runImageBenchmark(arguments.at(1));
+
+    if (mode == QStringLiteral("read") && arguments.size() == 2)
+        return runReadBenchmark(arguments.at(1));
+
+    if (mode == QStringLiteral("replace") && arguments.size() <= 2)
+        return runReplaceBenchmark(arguments.value(1, QStringLiteral("1000000")).toInt());
+
+    if (mode == QStringLiteral("smallfiles") && (arguments.size() == 2 || arguments.size() == 3)) {
+        const int ioConcurrency = arguments.value(2, QStringLiteral("2")).toInt();
+
+        return runSmallFileBenchmark(arguments.at(1), ioConcurrency);
+    }
+
+    return printUsage();
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "readbenchmark.h"
+#include "benchmark.h"
+
+#include "filehash/filereader.h"
+#include "filehash/xxhash64.h"
+
+#include <QFileInfo>
+
+namespace {
+
+constexpr int repeatCount = 5;
+
+} // anonymous
+
+int runReadBenchmark(const QString &filePath)
+{
+    const qint64 fileSize = QFileInfo(filePath).size();
+
+    if (fileSize <= 0) {
+        std::fprintf(stderr, "read: %s is empty or missing\n", qPrintable(filePath));
+        return 1;
+    }
+
+    const struct {
+        const char *name;
+        FileReader::Strategy strategy;
+    } strategies[] = {
+        {"pread 1 MiB", FileReader::Strategy::Buffered},
+        {"mmap", FileReader::Strategy::MemoryMapped},
+    };
+
+    std::printf("%s, %lld MiB\n", qPrintable(filePath), fileSize >> 20);
+
+    for (const auto &[name, strategy] : strategies) {
+        const FileReader reader(filePath, strategy);
+        bool isOk = true;
+
+        const double seconds = Benchmark::medianSeconds(repeatCount, [&]() {
+            Benchmark::evict(filePath);
+        }, [&]() {
+            XxHash64 hash;
+
+            isOk = reader.read([&hash](QByteArrayView data) { hash.addData(data); }) && isOk;
+        });
+
+        if (!isOk) {
+            std::fprintf(stderr, "read: %s can not be read\n", qPrintable(filePath));
+            return 1;
+        }
+
+        Benchmark::printRate(QString::fromLatin1(name), double(fileSize) / 1e6 / seconds, "MB/s");
+    }
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "replacebenchmark.h"
+#include "benchmark.h"
+
+#include <QRegularExpression>
+#include <QStringList>
+#include <QStringMatcher>
+
+namespace {
+
+constexpr int repeatCount = 3;
+
+// one name in ten matches the literal
+QStringList generatedNames(int nameCount)
+{
+    QStringList names;
+
+    names.reserve(nameCount);
+
+    for (int i = 0; i < nameCount; ++i) {
+        names.append((i % 10 == 0) ? QStringLiteral("IMG_%1_holiday.jpg").arg(i)
+                                   : QStringLiteral("IMG_%1.jpg").arg(i));
+    }
+
+    return names;
+}
+
+// the literal path of ReplaceString::build
+void replaceByMatcher(QString &result, const QStringMatcher &matcher, QStringView after)
+{
+    qsizetype index = matcher.indexIn(result);
+
+    if (index == -1)
+        return;
+
+    QString replaced;
+    qsizetype from = 0;
+
+    replaced.reserve(result.size() + after.size());
+
+    do {
+        replaced.append(QStringView{result}.sliced(from, index - from));
+        replaced.append(after);
+
+        from = index + matcher.pattern().size();
+        index = matcher.indexIn(result, from);
+    } while (index != -1);
+
+    replaced.append(QStringView{result}.sliced(from));
+
+    result.swap(replaced);
+}
+
+} // anonymous
+
+int runReplaceBenchmark(int nameCount)
+{
+    if (nameCount <= 0) {
+        std::fprintf(stderr, "replace: the name count must be positive\n");
+        return 1;
+    }
+
+    const QStringList names = generatedNames(nameCount);
+    const QString before = QStringLiteral("holiday");
+    const QString after = QStringLiteral("trip");
+    const QString pattern = QStringLiteral("IMG_(\\d+)");
+    const QString replacement = QStringLiteral("photo_\\1");
+
+    auto measure = [&names](const auto &replace) {
+        const double seconds = Benchmark::medianSeconds(repeatCount, [&]() {
+            for (const QString &name : names) {
+                QString result = name;
+
+                replace(result);
+            }
+        });
+
+        return double(names.size()) / seconds;
+    };
+
+    std::printf("%d names\n", nameCount);
+
+    Benchmark::printRate(QStringLiteral("literal, QString::replace"), measure([&](QString &result) {
+        result.replace(before, after, Qt::CaseSensitive);
+    }), "names/s");
+
+    const QStringMatcher matcher(before, Qt::CaseSensitive);
+
+    Benchmark::printRate(QStringLiteral("literal, QStringMatcher"), measure([&](QString &result) {
+        replaceByMatcher(result, matcher, after);
+    }), "names/s");
+
+    Benchmark::printRate(QStringLiteral("regexp, compiled per name"), measure([&](QString &result) {
+        result.replace(QRegularExpression(pattern), replacement);
+    }), "names/s");
+
+    QRegularExpression regExp(pattern);
+
+    regExp.optimize();
+
+    Benchmark::printRate(QStringLiteral("regexp, compiled once"), measure([&](QString &result) {
+        result.replace(regExp, replacement);
+    }), "names/s");
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "smallfilebenchmark.h"
+#include "benchmark.h"
+
+#include "filehash/filereader.h"
+#include "filehash/uringbatchreader.h"
+#include "filehash/xxhash64.h"
+
+#include <QDir>
+#include <QFile>
+#include <QThreadPool>
+
+#include <atomic>
+
+namespace {
+
+constexpr int repeatCount = 3;
+
+// as FileHashService
+constexpr unsigned ioUringQueueDepth = 64;
+constexpr qsizetype ioUringBatchSize = 128;
+
+void hashFile(const QString &filePath)
+{
+    XxHash64 hash;
+
+    FileReader(filePath).read([&hash](QByteArrayView data) { hash.addData(data); });
+}
+
+void hashByThreads(const QStringList &filePaths, int threadCount)
+{
+    QThreadPool threadPool;
+    std::atomic<qsizetype> next = 0;
+
+    threadPool.setMaxThreadCount(threadCount);
+
+    for (int i = 0; i < threadCount; ++i) {
+        threadPool.start([&filePaths, &next]() {
+            for (qsizetype index = next++; index < filePaths.size(); index = next++)
+                hashFile(filePaths.at(index));
+        });
+    }
+
+    threadPool.waitForDone();
+}
+
+void hashByUring(const QStringList &filePaths, int ioConcurrency)
+{
+    UringBatchReader reader(ioUringQueueDepth, ioConcurrency);
+
+    for (qsizetype first = 0; first < filePaths.size(); first += ioUringBatchSize) {
+        const qsizetype last = qMin(first + ioUringBatchSize, filePaths.size());
+        QList<UringBatchReader::Request> requests;
+
+        for (qsizetype i = first; i < last; ++i)
+            requests.append({QFile::encodeName(filePaths.at(i)), QByteArray{}, false});
+
+        reader.read(requests);
+
+        for (qsizetype i = 0; i < requests.size(); ++i) {
+            if (requests.at(i).isComplete) {
+                XxHash64 hash;
+
+                hash.addData(requests.at(i).content);
+            } else {
+                hashFile(filePaths.at(first + i));
+            }
+        }
+    }
+}
+
+} // anonymous
+
+int runSmallFileBenchmark(const QString &dirPath, int ioConcurrency)
+{
+    QStringList filePaths;
+    qint64 totalSize = 0;
+
+    for (const QFileInfo &fileInfo : QDir(dirPath).entryInfoList(QDir::Files)) {
+        filePaths << fileInfo.absoluteFilePath();
+        totalSize += fileInfo.size();
+    }
+
+    if (filePaths.isEmpty()) {
+        std::fprintf(stderr, "smallfiles: no file in %s\n", qPrintable(dirPath));
+        return 1;
+    }
+
+    std::printf("%s, %lld files of %lld KiB on average, %d reads in flight\n",
+                qPrintable(dirPath), qsizetype(filePaths.size()),
+                totalSize / filePaths.size() / 1024, ioConcurrency);
+
+    for (bool isCold : {true, false}) {
+        const QString cache = QString::fromLatin1(isCold ? "cold" : "warm");
+
+        auto prepare = [&]() {
+            for (const QString &filePath : filePaths) {
+                if (isCold)
+                    Benchmark::evict(filePath);
+            }
+        };
+
+        const double threadSeconds = Benchmark::medianSeconds(repeatCount, prepare, [&]() {
+            hashByThreads(filePaths, ioConcurrency);
+        });
+
+        Benchmark::printRate(QStringLiteral("thread pool, %1").arg(cache),
+                             double(filePaths.size()) / threadSeconds, "files/s");
+
+        if (!UringBatchReader::isSupported()) {
+            std::printf("io_uring is not available\n");
+            continue;
+        }
+
+        const double uringSeconds = Benchmark::medianSeconds(repeatCount, prepare, [&]() {
+            hashByUring(filePaths, ioConcurrency);
+        });
+
+        Benchmark::printRate(QStringLiteral("io_uring, %1").arg(cache),
+                             double(filePaths.size()) / uringSeconds, "files/s");
+    }
+
+    return 0;
+}
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "blake3.h"
+
+#include <QtConcurrent>
+#include <QtEndian>
+
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+constexpr qsizetype chunkLength = 1024;
+constexpr qsizetype blockLength = 64;
+constexpr quint64 chunksPerTask = 64;
+// 16 MiB. FileReader hands over 1 MiB at a time while the pool already hashes other files,
+// so only a single large update, e.g. from a caller hashing one buffer, is split.
+constexpr quint64 parallelThreshold = 16 * 1024;
+
+enum Flag : quint32 {
+    ChunkStart = 1 << 0,
+    ChunkEnd = 1 << 1,
+    Parent = 1 << 2,
+    Root = 1 << 3,
+};
+
+constexpr Blake3::ChainingValue iv = {
+    0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+    0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+constexpr std::array<size_t, 16> messagePermutation = {
+    2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8,
+};
+
+using Words = std::array<quint32, 16>;
+
+constexpr quint32 rotateRight(quint32 value, int bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+inline void mix(Words &state, size_t a, size_t b, size_t c, size_t d, quint32 x, quint32 y)
+{
+    state[a] = state[a] + state[b] + x;
+    state[d] = rotateRight(state[d] ^ state[a], 16);
+    state[c] = state[c] + state[d];
+    state[b] = rotateRight(state[b] ^ state[c], 12);
+    state[a] = state[a] + state[b] + y;
+    state[d] = rotateRight(state[d] ^ state[a], 8);
+    state[c] = state[c] + state[d];
+    state[b] = rotateRight(state[b] ^ state[c], 7);
+}
+
+Words compress(const Blake3::ChainingValue &chainingValue, Words message,
+               quint64 counter, quint32 size, quint32 flags)
+{
+    Words state = {
+        chainingValue[0], chainingValue[1], chainingValue[2], chainingValue[3],
+        chainingValue[4], chainingValue[5], chainingValue[6], chainingValue[7],
+        iv[0], iv[1], iv[2], iv[3],
+        quint32(counter), quint32(counter >> 32), size, flags,
+    };
+
+    for (int round = 0; round < 7; ++round) {
+        mix(state, 0, 4, 8, 12, message[0], message[1]);
+        mix(state, 1, 5, 9, 13, message[2], message[3]);
+        mix(state, 2, 6, 10, 14, message[4], message[5]);
+        mix(state, 3, 7, 11, 15, message[6], message[7]);
+        mix(state, 0, 5, 10, 15, message[8], message[9]);
+        mix(state, 1, 6, 11, 12, message[10], message[11]);
+        mix(state, 2, 7, 8, 13, message[12], message[13]);
+        mix(state, 3, 4, 9, 14, message[14], message[15]);
+
+        Words permuted;
+
+        for (size_t i = 0; i < permuted.size(); ++i)
+            permuted[i] = message[messagePermutation[i]];
+
+        message = permuted;
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        state[i] ^= state[i + 8];
+        state[i + 8] ^= chainingValue[i];
+    }
+
+    return state;
+}
+
+Blake3::ChainingValue firstEight(const Words &words)
+{
+    Blake3::ChainingValue chainingValue;
+
+    std::copy_n(words.begin(), chainingValue.size(), chainingValue.begin());
+
+    return chainingValue;
+}
+
+Words toWords(const uchar *block)
+{
+    Words words;
+
+    for (size_t i = 0; i < words.size(); ++i)
+        words[i] = qFromLittleEndian<quint32>(block + i * 4);
+
+    return words;
+}
+
+Words parentWords(const Blake3::ChainingValue &left, const Blake3::ChainingValue &right)
+{
+    Words words;
+
+    std::copy(left.begin(), left.end(), words.begin());
+    std::copy(right.begin(), right.end(), words.begin() + 8);
+
+    return words;
+}
+
+Blake3::ChainingValue parentChainingValue(const Blake3::ChainingValue &left,
+                                          const Blake3::ChainingValue &right)
+{
+    return firstEight(compress(iv, parentWords(left, right), 0, blockLength, Parent));
+}
+
+} // anonymous
+
+Blake3::ChunkState::ChunkState(quint64 chunkCounter)
+    : chainingValue(iv),
+      counter(chunkCounter)
+{
+}
+
+qsizetype Blake3::ChunkState::size() const
+{
+    return qsizetype(compressedBlockCount) * blockLength + blockSize;
+}
+
+void Blake3::ChunkState::update(const uchar *data, qsizetype size)
+{
+    while (size > 0) {
+        if (blockSize == quint32(blockLength)) {
+            const quint32 flags = (compressedBlockCount == 0) ? ChunkStart : 0;
+
+            chainingValue = firstEight(compress(chainingValue, toWords(block.data()), counter,
+                                                blockSize, flags));
+            ++compressedBlockCount;
+            block.fill(0);
+            blockSize = 0;
+        }
+
+        const qsizetype take = qMin(blockLength - qsizetype(blockSize), size);
+
+        std::memcpy(block.data() + blockSize, data, size_t(take));
+        blockSize += quint32(take);
+        data += take;
+        size -= take;
+    }
+}
+
+Blake3::ChainingValue Blake3::ChunkState::finalChainingValue() const
+{
+    const quint32 flags = ((compressedBlockCount == 0) ? ChunkStart : 0) | ChunkEnd;
+
+    return firstEight(compress(chainingValue, toWords(block.data()), counter, blockSize, flags));
+}
+
+std::array<quint32, 16> Blake3::ChunkState::rootWords() const
+{
+    const quint32 flags = ((compressedBlockCount == 0) ? ChunkStart : 0) | ChunkEnd | Root;
+
+    return compress(chainingValue, toWords(block.data()), counter, blockSize, flags);
+}
+
+Blake3::Blake3()
+    : m_chunkState(0)
+{
+}
+
+void Blake3::addData(QByteArrayView data)
+{
+    addData(reinterpret_cast<const uchar *>(data.data()), data.size());
+}
+
+QByteArray Blake3::result() const
+{
+    Words rootWords;
+
+    if (m_stackSize == 0) {
+        rootWords = m_chunkState.rootWords();
+    } else {
+        ChainingValue right = m_chunkState.finalChainingValue();
+
+        for (int i = m_stackSize - 1; i > 0; --i)
+            right = parentChainingValue(m_stack[size_t(i)], right);
+
+        rootWords = compress(iv, parentWords(m_stack[0], right), 0, blockLength, Parent | Root);
+    }
+
+    QByteArray digest(32, Qt::Uninitialized);
+
+    for (size_t i = 0; i < 8; ++i)
+        qToLittleEndian<quint32>(rootWords[i], digest.data() + i * 4);
+
+    return digest;
+}
+
+void Blake3::addData(const uchar *data, qsizetype size)
+{
+    while (size > 0) {
+        if (m_chunkState.size() == chunkLength) {
+            const quint64 totalChunks = m_chunkState.counter + 1;
+
+            pushChunkChainingValue(m_chunkState.finalChainingValue(), totalChunks);
+            m_chunkState = ChunkState(totalChunks);
+        }
+
+        // whole chunks followed by more input can never be the root. hash them in bulk.
+        if (m_chunkState.size() == 0 && size > chunkLength) {
+            const quint64 chunkCount = quint64((size - 1) / chunkLength);
+
+            addFullChunks(data, chunkCount);
+            data += chunkCount * chunkLength;
+            size -= qsizetype(chunkCount) * chunkLength;
+            m_chunkState = ChunkState(m_chunkState.counter + chunkCount);
+        }
+
+        const qsizetype take = qMin(chunkLength - m_chunkState.size(), size);
+
+        m_chunkState.update(data, take);
+        data += take;
+        size -= take;
+    }
+}
+
+void Blake3::addFullChunks(const uchar *data, quint64 chunkCount)
+{
+    const quint64 firstCounter = m_chunkState.counter;
+
+    std::vector<ChainingValue> chainingValues(chunkCount);
+
+    auto hashChunks = [&](quint64 first, quint64 last) {
+        for (quint64 i = first; i < last; ++i) {
+            ChunkState chunk(firstCounter + i);
+
+            chunk.update(data + i * chunkLength, chunkLength);
+            chainingValues[i] = chunk.finalChainingValue();
+        }
+    };
+
+    if (chunkCount < parallelThreshold) {
+        hashChunks(0, chunkCount);
+    } else {
+        std::vector<quint64> tasks((chunkCount + chunksPerTask - 1) / chunksPerTask);
+
+        std::iota(tasks.begin(), tasks.end(), 0);
+
+        QtConcurrent::blockingMap(tasks, [&](quint64 task) {
+            hashChunks(task * chunksPerTask, qMin(chunkCount, (task + 1) * chunksPerTask));
+        });
+    }
+
+    for (quint64 i = 0; i < chunkCount; ++i)
+        pushChunkChainingValue(chainingValues[i], firstCounter + i + 1);
+}
+
+void Blake3::pushChunkChainingValue(ChainingValue chainingValue, quint64 totalChunks)
+{
+    // merges completed subtrees. the number of trailing zero bits is the number of merges.
+    for (; (totalChunks & 1) == 0; totalChunks >>= 1)
+        chainingValue = parentChainingValue(m_stack[size_t(--m_stackSize)], chainingValue);
+
+    m_stack[size_t(m_stackSize++)] = chainingValue;
+}
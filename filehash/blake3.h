@@ -0,0 +1,62 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+#include <array>
+
+// BLAKE3 with the default 32 byte output.
+// A single update of 16 MiB or more is split into chunk groups hashed on the global thread
+// pool. The smaller updates of the file readers stay on the calling thread.
+class Blake3
+{
+public:
+    using ChainingValue = std::array<quint32, 8>;
+
+    Blake3();
+
+    void addData(QByteArrayView data);
+    QByteArray result() const;
+
+private:
+    struct ChunkState {
+        ChainingValue chainingValue;
+        quint64 counter = 0;
+        std::array<uchar, 64> block{};
+        quint32 blockSize = 0;
+        quint32 compressedBlockCount = 0;
+
+        explicit ChunkState(quint64 chunkCounter);
+        qsizetype size() const;
+        void update(const uchar *data, qsizetype size);
+        ChainingValue finalChainingValue() const;
+        std::array<quint32, 16> rootWords() const;
+    };
+
+    void addData(const uchar *data, qsizetype size);
+    void addFullChunks(const uchar *data, quint64 chunkCount);
+    void pushChunkChainingValue(ChainingValue chainingValue, quint64 totalChunks);
+
+    ChunkState m_chunkState;
+    std::array<ChainingValue, 54> m_stack;
+    int m_stackSize = 0;
+};
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crc32c.h"
+
+#include <QtEndian>
+
+#include <array>
+
+#if defined(Q_PROCESSOR_X86_64) && defined(Q_CC_GNU)
+#include <nmmintrin.h>
+#define CRC32C_HAS_SSE42
+#endif
+
+namespace {
+
+using Table = std::array<std::array<quint32, 256>, 8>;
+
+constexpr Table makeTables()
+{
+    Table tables{};
+
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 crc = i;
+
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78 : 0);
+
+        tables[0][i] = crc;
+    }
+
+    for (size_t slice = 1; slice < 8; ++slice) {
+        for (size_t i = 0; i < 256; ++i) {
+            const quint32 previous = tables[slice - 1][i];
+
+            tables[slice][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+        }
+    }
+
+    return tables;
+}
+
+constexpr Table tables = makeTables();
+
+// slicing-by-8
+quint32 updateBySoftware(quint32 crc, const uchar *data, qsizetype size)
+{
+    for (; size >= 8; size -= 8, data += 8) {
+        const quint32 low = qFromLittleEndian<quint32>(data) ^ crc;
+        const quint32 high = qFromLittleEndian<quint32>(data + 4);
+
+        crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF]
+              ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24]
+              ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF]
+              ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+    }
+
+    for (; size > 0; --size, ++data)
+        crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xFF];
+
+    return crc;
+}
+
+#ifdef CRC32C_HAS_SSE42
+__attribute__((target("sse4.2")))
+quint32 updateBySse42(quint32 crc, const uchar *data, qsizetype size)
+{
+    quint64 crc64 = crc;
+
+    for (; size >= 8; size -= 8, data += 8)
+        crc64 = _mm_crc32_u64(crc64, qFromUnaligned<quint64>(data));
+
+    crc = quint32(crc64);
+
+    for (; size > 0; --size, ++data)
+        crc = _mm_crc32_u8(crc, *data);
+
+    return crc;
+}
+
+const bool hasSse42 = __builtin_cpu_supports("sse4.2");
+#endif
+
+} // anonymous
+
+void Crc32c::addData(QByteArrayView data)
+{
+    auto bytes = reinterpret_cast<const uchar *>(data.data());
+
+#ifdef CRC32C_HAS_SSE42
+    if (hasSse42) {
+        m_crc = updateBySse42(m_crc, bytes, data.size());
+        return;
+    }
+#endif
+
+    m_crc = updateBySoftware(m_crc, bytes, data.size());
+}
+
+QByteArray Crc32c::result() const
+{
+    QByteArray digest(sizeof(quint32), Qt::Uninitialized);
+
+    qToBigEndian<quint32>(~m_crc, digest.data());
+
+    return digest;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "duplicatefinder.h"
+#include "filehashcalculator.h"
+#include "path/inodegroups.h"
+#include "path/pathentity.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace {
+constexpr FileHash::Algorithm prefixAlgorithm = FileHash::Algorithm::XxHash64;
+constexpr FileHash::Algorithm contentAlgorithm = FileHash::Algorithm::Blake3;
+
+// calls func for every index of the groups on the global thread pool.
+template <typename Func>
+void forEachMember(const QList<QList<qsizetype>> &groups, const std::function<bool()> &isCanceled,
+                   Func func)
+{
+    std::vector<qsizetype> indices;
+
+    for (const QList<qsizetype> &group : groups)
+        indices.insert(indices.end(), group.cbegin(), group.cend());
+
+    QtConcurrent::blockingMap(indices, [&](qsizetype index) {
+        if (!isCanceled())
+            func(index);
+    });
+}
+
+} // anonymous
+
+DuplicateFinder::DuplicateFinder(const EntityList &entities, const Path::InodeGroups *inodeGroups)
+    : m_entities(entities),
+      m_inodeGroups(inodeGroups),
+      m_inodeEntityCounts(entities.size(), 0)
+{
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i)
+        ++m_inodeEntityCounts[m_inodeGroups != nullptr ? m_inodeGroups->leaderOf(i) : i];
+}
+
+QList<int> DuplicateFinder::find(const std::function<bool()> &isCanceled)
+{
+    QList<int> groupNumbers(m_entities.size(), 0);
+
+    // 1st stage, by size. only the leaders of inodes are read
+    QList<Group> groups{Group{}};
+
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i) {
+        if (m_inodeEntityCounts.at(i) > 0 && !m_entities.at(i)->isDir())
+            groups.first().append(i);
+    }
+
+    std::vector<qint64> sizes(m_entities.size(), 0); // 0 excludes empty and missing files
+
+    forEachMember(groups, isCanceled, [&](qsizetype index) {
+        sizes[size_t(index)] = QFileInfo(m_entities.at(index)->fullPath()).size();
+    });
+
+    // a group of one inode is hard links only. it needs no more reads
+    QList<Group> sameInodeGroups;
+
+    auto takeSameInodeGroups = [&sameInodeGroups](QList<Group> &stageGroups) {
+        const auto itr = std::stable_partition(stageGroups.begin(), stageGroups.end(),
+                                               [](const Group &group) { return group.size() > 1; });
+
+        sameInodeGroups.append(QList<Group>(itr, stageGroups.end()));
+        stageGroups.erase(itr, stageGroups.end());
+    };
+
+    groups = splitGroups(groups, sizes);
+    takeSameInodeGroups(groups);
+
+    // 2nd stage, by sampled blocks
+    std::vector<QByteArray> prefixes(m_entities.size());
+
+    forEachMember(groups, isCanceled, [&](qsizetype index) {
+        FileHashCalculator fileHash(m_entities.at(index)->fullPath());
+
+        prefixes[size_t(index)] = fileHash.sampledResult(prefixAlgorithm, prefixSampleCount)
+                                          .bytes().toByteArray();
+    });
+
+    groups = splitGroups(groups, prefixes);
+    takeSameInodeGroups(groups);
+
+    // 3rd stage, by the whole content
+    std::vector<QByteArray> digests(m_entities.size());
+
+    forEachMember(groups, isCanceled, [&](qsizetype index) {
+        const SharedEntity &entity = m_entities.at(index);
+        FileDigest digest = entity->fileDigest(contentAlgorithm);
+
+        if (digest.isEmpty()) {
+            FileHashCalculator fileHash(entity->fullPath());
+
+            digest = fileHash.result(contentAlgorithm);
+
+            if (!digest.isEmpty())
+                entity->setFileDigest(digest);
+        }
+
+        digests[size_t(index)] = digest.bytes().toByteArray();
+    });
+
+    groups = splitGroups(groups, digests);
+    groups.append(sameInodeGroups);
+
+    if (isCanceled())
+        return groupNumbers;
+
+    // groups of leaders. numbered by their first entity
+    std::sort(groups.begin(), groups.end(), [](const Group &lhs, const Group &rhs) {
+        return lhs.first() < rhs.first();
+    });
+
+    QList<int> leaderGroupNumbers(m_entities.size(), 0);
+
+    for (qsizetype i = 0, count = groups.size(); i < count; ++i) {
+        for (qsizetype leader : groups.at(i))
+            leaderGroupNumbers[leader] = int(i + 1);
+    }
+
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i)
+        groupNumbers[i] = leaderGroupNumbers.at(m_inodeGroups != nullptr ? m_inodeGroups->leaderOf(i) : i);
+
+    return groupNumbers;
+}
+
+// splits every group by the key of its members, and keeps the groups which still hold
+// two or more entities. a default-constructed key means the member can not be compared.
+template <typename Key>
+QList<DuplicateFinder::Group> DuplicateFinder::splitGroups(const QList<Group> &groups,
+                                                           const std::vector<Key> &keys) const
+{
+    QList<Group> result;
+
+    for (const Group &group : groups) {
+        QHash<Key, Group> keyToGroup;
+
+        for (qsizetype index : group) {
+            const Key &key = keys.at(size_t(index));
+
+            if (key != Key{})
+                keyToGroup[key].append(index);
+        }
+
+        for (const Group &subGroup : std::as_const(keyToGroup)) {
+            int entityCount = 0;
+
+            for (qsizetype index : subGroup)
+                entityCount += m_inodeEntityCounts.at(index);
+
+            if (entityCount > 1)
+                result.append(subGroup);
+        }
+    }
+
+    return result;
+}
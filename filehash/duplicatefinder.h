@@ -0,0 +1,55 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "path/usingpathentity.h"
+
+#include <functional>
+
+namespace Path {
+class InodeGroups;
+}
+
+// Finds files of the same content in the way of fdupes. Files are grouped by size,
+// then by a hash of a few sampled blocks, and only the files still colliding are hashed
+// in full. Each stage runs on the global thread pool.
+class DuplicateFinder
+{
+public:
+    // inodeGroups may be nullptr. entities of the same inode count as duplicates
+    // of each other and are read once.
+    DuplicateFinder(const EntityList &entities, const Path::InodeGroups *inodeGroups);
+
+    // returns the group number of each entity, numbered from 1 in the order of the entities.
+    // 0 for dirs, empty files, unreadable files and files without duplicates.
+    // full hashes are stored to the entities for the FileHash builders.
+    QList<int> find(const std::function<bool()> &isCanceled);
+
+    static constexpr int prefixSampleCount = 4;
+
+private:
+    using Group = QList<qsizetype>;
+
+    template <typename Key>
+    QList<Group> splitGroups(const QList<Group> &groups, const std::vector<Key> &keys) const;
+
+    const EntityList &m_entities;
+    const Path::InodeGroups *m_inodeGroups;
+    QList<int> m_inodeEntityCounts; // of leaders. the number of entities sharing the inode
+};
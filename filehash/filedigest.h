@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "filehashalgorithm.h"
+
+#include <QByteArrayView>
+
+#include <array>
+#include <cstring>
+
+// A binary digest stored inline. Hex text is made only when it is inserted into a name.
+class FileDigest
+{
+public:
+    static constexpr qsizetype maxSize = 32; // the longest offered algorithm
+
+    FileDigest() = default;
+
+    FileDigest(FileHash::Algorithm algorithm, QByteArrayView bytes)
+        : m_algorithm(algorithm),
+          m_size(quint8(qMin(bytes.size(), maxSize)))
+    {
+        Q_ASSERT(bytes.size() <= maxSize);
+
+        std::memcpy(m_bytes.data(), bytes.data(), m_size);
+    }
+
+    FileHash::Algorithm algorithm() const
+    {
+        return m_algorithm;
+    }
+
+    bool isEmpty() const
+    {
+        return m_size == 0;
+    }
+
+    QByteArrayView bytes() const
+    {
+        return QByteArrayView(m_bytes.data(), m_size);
+    }
+
+private:
+    FileHash::Algorithm m_algorithm = FileHash::Algorithm::Md5;
+    quint8 m_size = 0;
+    std::array<char, maxSize> m_bytes;
+};
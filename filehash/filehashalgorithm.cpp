@@ -0,0 +1,69 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filehashalgorithm.h"
+
+namespace FileHash {
+
+QString algorithmName(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::Md5:
+        return QStringLiteral("MD5");
+    case Algorithm::Sha1:
+        return QStringLiteral("SHA1");
+    case Algorithm::Sha224:
+        return QStringLiteral("SHA2-224");
+    case Algorithm::Sha256:
+        return QStringLiteral("SHA2-256");
+    case Algorithm::Sha3_224:
+        return QStringLiteral("SHA3-224");
+    case Algorithm::Sha3_256:
+        return QStringLiteral("SHA3-256");
+    case Algorithm::Crc32c:
+        return QStringLiteral("CRC32C");
+    case Algorithm::XxHash64:
+        return QStringLiteral("XXH64");
+    case Algorithm::Blake3:
+        return QStringLiteral("BLAKE3");
+    }
+
+    return QString{};
+}
+
+int digestLength(Algorithm algorithm)
+{
+    switch (algorithm) {
+    case Algorithm::Crc32c:
+        return 4;
+    case Algorithm::XxHash64:
+        return 8;
+    case Algorithm::Blake3:
+        return 32;
+    default:
+        return QCryptographicHash::hashLength(QCryptographicHash::Algorithm(algorithm));
+    }
+}
+
+bool isCryptographic(Algorithm algorithm)
+{
+    return int(algorithm) < int(Algorithm::Crc32c);
+}
+
+} // FileHash
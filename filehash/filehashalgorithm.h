@@ -0,0 +1,50 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QCryptographicHash>
+#include <QString>
+
+namespace FileHash {
+
+// The QCryptographicHash members keep their values so that saved settings stay valid.
+enum class Algorithm : int {
+    Md5 = QCryptographicHash::Md5,
+    Sha1 = QCryptographicHash::Sha1,
+    Sha224 = QCryptographicHash::Sha224,
+    Sha256 = QCryptographicHash::Sha256,
+    Sha3_224 = QCryptographicHash::Sha3_224,
+    Sha3_256 = QCryptographicHash::Sha3_256,
+
+    Crc32c = 0x100,
+    XxHash64,
+    Blake3,
+};
+
+inline size_t qHash(Algorithm algorithm, size_t seed = 0) noexcept
+{
+    return ::qHash(int(algorithm), seed);
+}
+
+QString algorithmName(Algorithm algorithm);
+int digestLength(Algorithm algorithm);
+bool isCryptographic(Algorithm algorithm);
+
+} // FileHash
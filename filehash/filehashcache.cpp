@@ -0,0 +1,297 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filehashcache.h"
+#include "xxhash64.h"
+
+#include "application.h"
+
+#include <QDir>
+#include <QSettings>
+#include <QtEndian>
+
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/file.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+Q_GLOBAL_STATIC(FileHashCache, fileHashCache)
+
+namespace Settings {
+constexpr char groupName[] = "FileHash";
+constexpr char keyCacheSizeMiB[] = "CacheSizeMiB";
+} // Settings
+
+constexpr quint32 cacheMagic = 0x46484331; // "FHC1"
+constexpr quint32 cacheVersion = 3;
+constexpr quint32 cacheHashFunction = 1; // XXH64 of the key in little endian
+constexpr qsizetype maxDigestLength = 64;
+constexpr quint64 probeWindow = 16;
+
+// the fields one after another, without the padding of Key, so that the slot index
+// does not depend on the compiler or the Qt version
+std::array<uchar, 36> keyBytes(const FileHashCache::Key &key)
+{
+    std::array<uchar, 36> bytes;
+
+    qToLittleEndian(key.device, bytes.data());
+    qToLittleEndian(key.inode, bytes.data() + 8);
+    qToLittleEndian(key.size, bytes.data() + 16);
+    qToLittleEndian(key.mtimeNs, bytes.data() + 24);
+    qToLittleEndian(key.algorithm, bytes.data() + 32);
+
+    return bytes;
+}
+
+} // anonymous
+
+struct FileHashCache::Header {
+    quint32 magic;
+    quint32 version;
+    quint32 slotSize;
+    quint32 hashFunction; // of the slot index and the checksum
+    quint64 slotCount;
+    quint64 clock;
+};
+
+struct FileHashCache::Slot {
+    Key key;
+    quint32 digestLength;
+    quint64 lastUsed; // 0 means empty
+    quint64 checksum; // of key and digest. a slot torn by a crash does not match
+    uchar digest[maxDigestLength];
+};
+
+FileHashCache::FileHashCache()
+{
+    if (!open())
+        m_file.close();
+}
+
+FileHashCache::~FileHashCache()
+{
+    if (m_header != nullptr)
+        m_file.unmap(reinterpret_cast<uchar *>(m_header));
+}
+
+FileHashCache &FileHashCache::instance()
+{
+    return *fileHashCache;
+}
+
+std::optional<FileHashCache::Key> FileHashCache::key(const QString &filePath,
+                                                      FileHash::Algorithm algorithm)
+{
+#ifdef Q_OS_UNIX
+    struct stat status;
+
+    if (::stat(QFile::encodeName(filePath).constData(), &status) != 0 || !S_ISREG(status.st_mode))
+        return std::nullopt;
+
+#if defined(Q_OS_DARWIN)
+    const qint64 mtimeNs = qint64(status.st_mtimespec.tv_sec) * 1000000000
+                           + status.st_mtimespec.tv_nsec;
+#else
+    const qint64 mtimeNs = qint64(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#endif
+
+    return Key{quint64(status.st_dev), quint64(status.st_ino), qint64(status.st_size),
+               mtimeNs, qint32(algorithm)};
+#else
+    Q_UNUSED(filePath)
+    Q_UNUSED(algorithm)
+
+    return std::nullopt; // no inode number on this platform
+#endif
+}
+
+bool FileHashCache::isEnabled() const
+{
+    return m_header != nullptr; // set only in the constructor
+}
+
+QByteArray FileHashCache::digest(const Key &key)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (m_header == nullptr)
+        return QByteArray{};
+
+    const quint64 first = hashOf(key);
+
+    for (quint64 i = 0; i < probeWindow; ++i) {
+        Slot *target = slot(first + i);
+
+        if (target->lastUsed == 0 || target->key != key)
+            continue;
+
+        const qsizetype length = qsizetype(target->digestLength);
+
+        if (length == 0 || length > maxDigestLength
+                || length != FileHash::digestLength(FileHash::Algorithm(key.algorithm))
+                || target->checksum != checksumOf(target)) {
+            return QByteArray{};
+        }
+
+        target->lastUsed = ++m_header->clock;
+
+        return QByteArray(reinterpret_cast<const char *>(target->digest),
+                          qsizetype(target->digestLength));
+    }
+
+    return QByteArray{};
+}
+
+void FileHashCache::insert(const Key &key, QByteArrayView digest)
+{
+    if (digest.isEmpty() || digest.size() > maxDigestLength)
+        return;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_header == nullptr)
+        return;
+
+    const quint64 first = hashOf(key);
+    Slot *target = slot(first);
+
+    for (quint64 i = 0; i < probeWindow; ++i) {
+        Slot *candidate = slot(first + i);
+
+        if (candidate->lastUsed != 0 && candidate->key == key) {
+            target = candidate;
+            break;
+        }
+
+        if (candidate->lastUsed < target->lastUsed)
+            target = candidate;
+    }
+
+    // the slot is emptied first and published last, so that a crash in between
+    // leaves an empty slot rather than a stale key with a new digest.
+    target->lastUsed = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+
+    target->digestLength = quint32(digest.size());
+    std::memcpy(target->digest, digest.data(), size_t(digest.size()));
+    target->key = key;
+    target->checksum = checksumOf(target);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    target->lastUsed = ++m_header->clock;
+}
+
+bool FileHashCache::open()
+{
+    QSharedPointer<QSettings> qSet = Application::mainQSettings();
+
+    qSet->beginGroup(Settings::groupName);
+
+    const qint64 cacheSize = qSet->value(Settings::keyCacheSizeMiB, 64).toLongLong() << 20;
+
+    qSet->endGroup();
+
+    const quint64 slotCount = quint64(qMax<qint64>(0, cacheSize) / qint64(sizeof(Slot)));
+
+    if (slotCount < probeWindow)
+        return false; // disabled
+
+    if (!QDir().mkpath(Application::settingsDirPath()))
+        return false;
+
+    m_file.setFileName(Application::settingsDirPath() + QStringLiteral("/filehash.cache"));
+
+    if (!m_file.open(QFile::ReadWrite))
+        return false;
+
+#ifdef Q_OS_UNIX
+    // another instance already uses the cache. this one goes without
+    if (::flock(m_file.handle(), LOCK_EX | LOCK_NB) != 0)
+        return false;
+#endif
+
+    const qint64 fileSize = qint64(sizeof(Header) + slotCount * sizeof(Slot));
+    bool isValid = (m_file.size() == fileSize);
+
+    if (isValid) {
+        Header header{};
+
+        isValid = m_file.read(reinterpret_cast<char *>(&header), sizeof(Header)) == sizeof(Header)
+                  && header.magic == cacheMagic && header.version == cacheVersion
+                  && header.slotSize == sizeof(Slot) && header.hashFunction == cacheHashFunction
+                  && header.slotCount == slotCount;
+    }
+
+    if (!isValid) { // new, broken or resized. start over.
+        if (!m_file.resize(0) || !m_file.resize(fileSize))
+            return false;
+    }
+
+    m_header = reinterpret_cast<Header *>(m_file.map(0, fileSize));
+
+    if (m_header == nullptr)
+        return false;
+
+    if (!isValid)
+        *m_header = Header{cacheMagic, cacheVersion, quint32(sizeof(Slot)), cacheHashFunction,
+                           slotCount, 0};
+
+    return true;
+}
+
+FileHashCache::Slot *FileHashCache::slot(quint64 index) const
+{
+    auto slots = reinterpret_cast<Slot *>(reinterpret_cast<uchar *>(m_header) + sizeof(Header));
+
+    return &slots[index % m_header->slotCount];
+}
+
+// qHash depends on the Qt version and may be seeded per process, so the table, which
+// outlives both, uses XXH64.
+quint64 FileHashCache::hashOf(const Key &key)
+{
+    const std::array<uchar, 36> bytes = keyBytes(key);
+    XxHash64 hash;
+
+    hash.addData(QByteArrayView(bytes.data(), qsizetype(bytes.size())));
+
+    return hash.value();
+}
+
+quint64 FileHashCache::checksumOf(const Slot *slot)
+{
+    const std::array<uchar, 36> bytes = keyBytes(slot->key);
+    const qsizetype length = qMin(qsizetype(slot->digestLength), maxDigestLength);
+    uchar digestLength[4];
+    XxHash64 hash;
+
+    qToLittleEndian(slot->digestLength, digestLength);
+
+    hash.addData(QByteArrayView(bytes.data(), qsizetype(bytes.size())));
+    hash.addData(QByteArrayView(digestLength, 4));
+    hash.addData(QByteArrayView(slot->digest, length));
+
+    return hash.value();
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "filehashalgorithm.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+
+#include <optional>
+
+// Digests kept across sessions in a memory-mapped open addressing table.
+// A file is identified by (device, inode, size, mtime) so renamed files still hit.
+// The table has a fixed size. When the probe window is full, the least recently used
+// entry in the window is evicted. Only one instance of the application uses the file.
+class FileHashCache
+{
+    Q_DISABLE_COPY_MOVE(FileHashCache)
+public:
+    struct Key {
+        quint64 device;
+        quint64 inode;
+        qint64 size;
+        qint64 mtimeNs;
+        qint32 algorithm;
+
+        bool operator==(const Key &other) const = default;
+    };
+
+    FileHashCache();
+    ~FileHashCache();
+
+    static FileHashCache &instance();
+    static std::optional<Key> key(const QString &filePath, FileHash::Algorithm algorithm);
+
+    bool isEnabled() const;
+
+    QByteArray digest(const Key &key);
+    void insert(const Key &key, QByteArrayView digest);
+
+private:
+    struct Header;
+    struct Slot;
+
+    bool open();
+    Slot *slot(quint64 index) const;
+    static quint64 hashOf(const Key &key);
+    static quint64 checksumOf(const Slot *slot);
+
+    QMutex m_mutex;
+    QFile m_file;
+    Header *m_header = nullptr;
+};
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filehashcalculator.h"
+#include "filehasher.h"
+#include "filehashstatistics.h"
+#include "filereader.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QtEndian>
+
+#include <memory>
+#include <vector>
+
+FileHashCalculator::FileHashCalculator(QStringView filePath)
+    : m_filePath(filePath.toString())
+{
+}
+
+FileDigest FileHashCalculator::result(FileHash::Algorithm algorithm)
+{
+    const QList<FileDigest> digests = results({algorithm});
+
+    return digests.isEmpty() ? FileDigest{} : digests.first();
+}
+
+QList<FileDigest> FileHashCalculator::results(const QList<FileHash::Algorithm> &algorithms)
+{
+    QList<FileHash::Algorithm> pendingAlgorithms = algorithms;
+    QList<FileDigest> digests = cachedResults(pendingAlgorithms);
+
+    if (pendingAlgorithms.isEmpty())
+        return digests;
+
+    FileReader reader(m_filePath);
+
+    const QList<FileDigest> computed = computeResults(pendingAlgorithms,
+                                                      [&reader](const auto &consume) {
+        return reader.read(consume);
+    });
+
+    if (computed.isEmpty())
+        return QList<FileDigest>{};
+
+    return digests + computed;
+}
+
+QList<FileDigest> FileHashCalculator::cachedResults(QList<FileHash::Algorithm> &algorithms)
+{
+    QList<FileDigest> digests;
+
+    for (auto itr = algorithms.begin(); itr != algorithms.end();) {
+        const std::optional<FileHashCache::Key> key = cacheKey(*itr);
+        const QByteArray cached = key.has_value() ? FileHashCache::instance().digest(*key)
+                                                  : QByteArray{};
+        if (cached.isEmpty()) {
+            ++itr;
+            continue;
+        }
+
+        digests.append(FileDigest(*itr, cached));
+        itr = algorithms.erase(itr);
+    }
+
+    return digests;
+}
+
+QList<FileDigest> FileHashCalculator::contentResults(const QList<FileHash::Algorithm> &algorithms,
+                                                     QByteArrayView content)
+{
+    return computeResults(algorithms, [content](const auto &consume) {
+        consume(content);
+        return true;
+    });
+}
+
+QList<FileDigest> FileHashCalculator::computeResults(const QList<FileHash::Algorithm> &algorithms,
+                                                     const Reader &read)
+{
+    QList<FileHash::Algorithm> uniqueAlgorithms;
+    std::vector<std::unique_ptr<FileHasher>> hashes;
+
+    for (FileHash::Algorithm algorithm : algorithms) {
+        if (uniqueAlgorithms.contains(algorithm))
+            continue;
+
+        uniqueAlgorithms.append(algorithm);
+        hashes.push_back(std::make_unique<FileHasher>(algorithm));
+    }
+
+    QElapsedTimer latencyTimer;
+    qint64 bytesRead = 0;
+    std::vector<qint64> cpuTimes(hashes.size(), 0);
+
+    latencyTimer.start();
+
+    bool isOk = read([&](QByteArrayView data) {
+        bytesRead += data.size();
+
+        for (size_t i = 0; i < hashes.size(); ++i) {
+            const qint64 cpuTimeBefore = FileHashStatistics::threadCpuTimeNs();
+
+            hashes[i]->addData(data);
+            cpuTimes[i] += FileHashStatistics::threadCpuTimeNs() - cpuTimeBefore;
+        }
+    });
+
+    if (!isOk)
+        return QList<FileDigest>{};
+
+    FileHashStatistics &statistics = FileHashStatistics::instance();
+
+    statistics.addFile(bytesRead, latencyTimer.nsecsElapsed());
+
+    for (size_t i = 0; i < hashes.size(); ++i)
+        statistics.addCpuTime(hashes[i]->algorithm(), cpuTimes[i]);
+
+    QList<FileDigest> digests;
+
+    for (qsizetype i = 0, count = uniqueAlgorithms.size(); i < count; ++i) {
+        const FileHash::Algorithm algorithm = uniqueAlgorithms.at(i);
+        const QByteArray digest = hashes[size_t(i)]->result();
+        const std::optional<FileHashCache::Key> key = cacheKey(algorithm);
+
+        if (key.has_value())
+            FileHashCache::instance().insert(*key, digest);
+
+        digests.append(FileDigest(algorithm, digest));
+    }
+
+    return digests;
+}
+
+std::optional<FileHashCache::Key> FileHashCalculator::cacheKey(FileHash::Algorithm algorithm)
+{
+    // one stat for all algorithms. only the algorithm differs between the keys.
+    if (!m_isCacheKeyLoaded) {
+        if (FileHashCache::instance().isEnabled())
+            m_cacheKey = FileHashCache::key(m_filePath, algorithm);
+
+        m_isCacheKeyLoaded = true;
+    }
+
+    if (!m_cacheKey.has_value())
+        return std::nullopt;
+
+    FileHashCache::Key key = *m_cacheKey;
+
+    key.algorithm = qint32(algorithm);
+
+    return key;
+}
+
+FileDigest FileHashCalculator::sampledResult(FileHash::Algorithm algorithm, int sampleCount)
+{
+    QFile file(m_filePath);
+
+    if (!file.open(QFile::ReadOnly | QFile::Unbuffered))
+        return FileDigest{};
+
+    FileHasher hasher(algorithm);
+    const qint64 fileSize = file.size();
+
+    char sizeBytes[sizeof(qint64)];
+
+    qToLittleEndian<qint64>(fileSize, sizeBytes);
+    hasher.addData(QByteArrayView(sizeBytes, sizeof(sizeBytes)));
+
+    const qint64 blockCount = qMax(1, sampleCount);
+    const qint64 lastOffset = qMax<qint64>(0, fileSize - sampleBlockSize);
+
+    QByteArray block(sampleBlockSize, Qt::Uninitialized);
+
+    for (qint64 i = 0; i < blockCount; ++i) {
+        const qint64 offset = (blockCount == 1) ? 0 : lastOffset * i / (blockCount - 1);
+
+        if (!file.seek(offset))
+            return FileDigest{};
+
+        const qint64 readSize = file.read(block.data(), sampleBlockSize);
+
+        if (readSize < 0)
+            return FileDigest{};
+
+        hasher.addData(QByteArrayView(block.constData(), readSize));
+
+        if (lastOffset == 0)
+            break; // the first block was the whole file
+    }
+
+    return FileDigest(algorithm, hasher.result());
+}
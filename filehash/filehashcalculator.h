@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "filedigest.h"
+#include "filehashcache.h"
+
+#include <QList>
+#include <QString>
+
+#include <functional>
+#include <optional>
+
+class FileHashCalculator
+{
+public:
+    FileHashCalculator(QStringView filePath);
+
+    // returns an empty digest if the file can not be read.
+    FileDigest result(FileHash::Algorithm algorithm);
+
+    // reads the file once and feeds every digest from the same buffer.
+    // returns an empty list if the file can not be read.
+    QList<FileDigest> results(const QList<FileHash::Algorithm> &algorithms);
+
+    // the two steps of results() for callers that read the file by themselves.
+    // cachedResults removes the algorithms it found from the list.
+    QList<FileDigest> cachedResults(QList<FileHash::Algorithm> &algorithms);
+    QList<FileDigest> contentResults(const QList<FileHash::Algorithm> &algorithms,
+                                     QByteArrayView content);
+
+    // hashes the file size and sampleCount evenly spaced blocks of sampleBlockSize bytes.
+    // the cost does not depend on the file size. the result is not a hash of the content.
+    FileDigest sampledResult(FileHash::Algorithm algorithm, int sampleCount);
+
+    static constexpr qint64 sampleBlockSize = 64 * 1024;
+
+private:
+    using Reader = std::function<bool(const std::function<void(QByteArrayView)> &)>;
+
+    QList<FileDigest> computeResults(const QList<FileHash::Algorithm> &algorithms,
+                                     const Reader &read);
+    std::optional<FileHashCache::Key> cacheKey(FileHash::Algorithm algorithm);
+
+    const QString m_filePath;
+    std::optional<FileHashCache::Key> m_cacheKey;
+    bool m_isCacheKeyLoaded = false;
+};
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filehasher.h"
+
+FileHasher::FileHasher(FileHash::Algorithm algorithm)
+    : m_algorithm(algorithm)
+{
+    using Algorithm = FileHash::Algorithm;
+
+    switch (algorithm) {
+    case Algorithm::Crc32c:
+        m_hasher.emplace<Crc32c>();
+        break;
+    case Algorithm::XxHash64:
+        m_hasher.emplace<XxHash64>();
+        break;
+    case Algorithm::Blake3:
+        m_hasher.emplace<Blake3>();
+        break;
+    default:
+        m_hasher = std::make_unique<QCryptographicHash>(QCryptographicHash::Algorithm(algorithm));
+        break;
+    }
+}
+
+FileHash::Algorithm FileHasher::algorithm() const
+{
+    return m_algorithm;
+}
+
+void FileHasher::addData(QByteArrayView data)
+{
+    std::visit([data](auto &hasher) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(hasher)>,
+                                     std::unique_ptr<QCryptographicHash>>) {
+            hasher->addData(data.data(), data.size());
+        } else {
+            hasher.addData(data);
+        }
+    }, m_hasher);
+}
+
+QByteArray FileHasher::result() const
+{
+    return std::visit([](const auto &hasher) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(hasher)>,
+                                     std::unique_ptr<QCryptographicHash>>) {
+            return hasher->result();
+        } else {
+            return hasher.result();
+        }
+    }, m_hasher);
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "blake3.h"
+#include "crc32c.h"
+#include "filehashalgorithm.h"
+#include "xxhash64.h"
+
+#include <memory>
+#include <variant>
+
+// Feeds data to the implementation of any FileHash::Algorithm.
+class FileHasher
+{
+    Q_DISABLE_COPY_MOVE(FileHasher)
+public:
+    explicit FileHasher(FileHash::Algorithm algorithm);
+
+    FileHash::Algorithm algorithm() const;
+
+    void addData(QByteArrayView data);
+    QByteArray result() const;
+
+private:
+    const FileHash::Algorithm m_algorithm;
+    std::variant<std::unique_ptr<QCryptographicHash>, Crc32c, XxHash64, Blake3> m_hasher;
+};
@@ -0,0 +1,285 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filehashservice.h"
+#include "filehashcalculator.h"
+#include "filehashstatistics.h"
+#include "uringbatchreader.h"
+
+#include "application.h"
+#include "path/inodegroups.h"
+#include "path/pathentity.h"
+
+#include <QFile>
+#include <QSettings>
+#include <QStorageInfo>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace {
+
+namespace Settings {
+constexpr char groupName[] = "FileHash";
+constexpr char keyIoConcurrencyPerDevice[] = "IoConcurrencyPerDevice";
+constexpr char keyUseIoUring[] = "UseIoUring";
+} // Settings
+
+// requests in flight on the ring of a device, and files per batch. the content of a batch
+// stays in memory until it is hashed, at most ioUringBatchSize * smallFileSize bytes.
+constexpr unsigned ioUringQueueDepth = 64;
+constexpr qsizetype ioUringBatchSize = 128;
+
+QByteArray deviceId(const QString &dirPath)
+{
+#ifdef Q_OS_UNIX
+    struct stat status;
+
+    if (::stat(QFile::encodeName(dirPath).constData(), &status) == 0)
+        return QByteArray::number(quint64(status.st_dev));
+#endif
+
+    return QStorageInfo(dirPath).rootPath().toUtf8();
+}
+
+} // anonymous
+
+FileHashService::FileHashService(const EntityList &entities,
+                                 const Path::InodeGroups *inodeGroups,
+                                 QList<FileHash::Algorithm> algorithms,
+                                 int ioConcurrencyPerDevice, bool isIoUringEnabled)
+    : m_entities(entities),
+      m_algorithms(algorithms),
+      m_ioConcurrencyPerDevice(qMax(1, ioConcurrencyPerDevice)),
+      m_isIoUringEnabled(isIoUringEnabled && UringBatchReader::isSupported()),
+      m_isDone(entities.size(), false)
+{
+    QHash<QString, QByteArray> dirToDevice;
+    QHash<QByteArray, DeviceQueue *> deviceToQueue;
+
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i) {
+        const SharedEntity &entity = m_entities.at(i);
+
+        const bool isFollower = inodeGroups != nullptr && !inodeGroups->isLeader(i);
+
+        if (entity->isDir() || m_algorithms.isEmpty() || isFollower) {
+            m_isDone[i] = true;
+            continue;
+        }
+
+        const QString parentPath = entity->parentPath();
+        auto itrDevice = dirToDevice.find(parentPath);
+
+        if (itrDevice == dirToDevice.end())
+            itrDevice = dirToDevice.insert(parentPath, deviceId(parentPath));
+
+        DeviceQueue *&queue = deviceToQueue[itrDevice.value()];
+
+        if (queue == nullptr) {
+            m_queues.push_back(std::make_unique<DeviceQueue>());
+            queue = m_queues.back().get();
+        }
+
+        queue->indices.append(i);
+    }
+
+    m_threadPool.setMaxThreadCount(qMax(1, int(m_queues.size()) * m_ioConcurrencyPerDevice));
+
+    FileHashStatistics::instance().addQueueDepth(m_isDone.count(false));
+}
+
+FileHashService::~FileHashService()
+{
+    cancel();
+    m_threadPool.waitForDone();
+
+    FileHashStatistics::instance().addQueueDepth(-m_isDone.count(false)); // canceled ones
+}
+
+void FileHashService::start()
+{
+    for (const std::unique_ptr<DeviceQueue> &queue : m_queues) {
+        // the ring of one worker already keeps ioConcurrencyPerDevice reads in flight
+        const int workerCount = m_isIoUringEnabled
+                                ? 1 : qMin(m_ioConcurrencyPerDevice, int(queue->indices.size()));
+
+        for (int i = 0; i < workerCount; ++i)
+            m_threadPool.start([this, deviceQueue = queue.get()]() { hashEntities(deviceQueue); });
+    }
+}
+
+void FileHashService::cancel()
+{
+    m_isCanceled = true;
+
+    QMutexLocker locker(&m_mutex);
+
+    m_doneCondition.wakeAll();
+}
+
+void FileHashService::waitForEntity(qsizetype index)
+{
+    QMutexLocker locker(&m_mutex);
+
+    while (!m_isDone.at(index) && !m_isCanceled)
+        m_doneCondition.wait(&m_mutex);
+}
+
+int FileHashService::ioConcurrencyPerDevice()
+{
+    QSharedPointer<QSettings> qSet = Application::mainQSettings();
+
+    qSet->beginGroup(Settings::groupName);
+
+    const int concurrency = qSet->value(Settings::keyIoConcurrencyPerDevice, 2).toInt();
+
+    qSet->endGroup();
+
+    return qMax(1, concurrency);
+}
+
+bool FileHashService::isIoUringEnabled()
+{
+    QSharedPointer<QSettings> qSet = Application::mainQSettings();
+
+    qSet->beginGroup(Settings::groupName);
+
+    const bool isEnabled = qSet->value(Settings::keyUseIoUring, false).toBool();
+
+    qSet->endGroup();
+
+    return isEnabled;
+}
+
+void FileHashService::hashEntities(DeviceQueue *queue)
+{
+    if (m_isIoUringEnabled && hashEntitiesInBatches(queue))
+        return;
+
+    while (!m_isCanceled) {
+        const qsizetype next = queue->next++;
+
+        if (next >= queue->indices.size())
+            return;
+
+        const qsizetype index = queue->indices.at(next);
+        const QList<FileHash::Algorithm> algorithms = missingAlgorithms(index);
+
+        if (!algorithms.isEmpty()) {
+            FileHashCalculator fileHash(m_entities.at(index)->fullPath());
+
+            for (const FileDigest &digest : fileHash.results(algorithms))
+                m_entities.at(index)->setFileDigest(digest);
+        }
+
+        setDone(index);
+    }
+}
+
+bool FileHashService::hashEntitiesInBatches(DeviceQueue *queue)
+{
+    UringBatchReader reader(ioUringQueueDepth, m_ioConcurrencyPerDevice);
+
+    if (!reader.isValid())
+        return false; // falls back to reading file by file
+
+    while (!m_isCanceled) {
+        const qsizetype first = queue->next.fetch_add(ioUringBatchSize);
+
+        if (first >= queue->indices.size())
+            return true;
+
+        const qsizetype last = qMin(first + ioUringBatchSize, queue->indices.size());
+
+        struct Pending {
+            qsizetype index;
+            FileHashCalculator fileHash;
+            QList<FileHash::Algorithm> algorithms;
+        };
+
+        std::vector<std::unique_ptr<Pending>> pendings;
+        QList<UringBatchReader::Request> requests;
+
+        for (qsizetype i = first; i < last; ++i) {
+            const qsizetype index = queue->indices.at(i);
+            const SharedEntity &entity = m_entities.at(index);
+            auto pending = std::make_unique<Pending>(
+                        Pending{index, FileHashCalculator(entity->fullPath()),
+                                missingAlgorithms(index)});
+
+            for (const FileDigest &digest : pending->fileHash.cachedResults(pending->algorithms))
+                entity->setFileDigest(digest);
+
+            if (pending->algorithms.isEmpty()) {
+                setDone(index);
+                continue;
+            }
+
+            requests.append(UringBatchReader::Request{QFile::encodeName(entity->fullPath()),
+                                                      QByteArray{}, false});
+            pendings.push_back(std::move(pending));
+        }
+
+        reader.read(requests);
+
+        for (size_t i = 0; i < pendings.size(); ++i) {
+            Pending &pending = *pendings[i];
+            const UringBatchReader::Request &request = requests.at(qsizetype(i));
+            const SharedEntity &entity = m_entities.at(pending.index);
+
+            // large or unreadable files are read as usual
+            const QList<FileDigest> digests =
+                    request.isComplete
+                    ? pending.fileHash.contentResults(pending.algorithms, request.content)
+                    : pending.fileHash.results(pending.algorithms);
+
+            for (const FileDigest &digest : digests)
+                entity->setFileDigest(digest);
+
+            setDone(pending.index);
+        }
+    }
+
+    return true;
+}
+
+QList<FileHash::Algorithm> FileHashService::missingAlgorithms(qsizetype index) const
+{
+    const SharedEntity &entity = m_entities.at(index);
+    QList<FileHash::Algorithm> algorithms;
+
+    for (FileHash::Algorithm algorithm : m_algorithms) {
+        if (entity->fileDigest(algorithm).isEmpty())
+            algorithms.append(algorithm);
+    }
+
+    return algorithms;
+}
+
+void FileHashService::setDone(qsizetype index)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_isDone.at(index))
+        FileHashStatistics::instance().addQueueDepth(-1);
+
+    m_isDone[index] = true;
+    m_doneCondition.wakeAll();
+}
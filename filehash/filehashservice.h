@@ -0,0 +1,88 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "filehashalgorithm.h"
+#include "path/usingpathentity.h"
+
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Path {
+class InodeGroups;
+}
+
+// Hashes files on a thread pool ahead of the name generator.
+// Files are grouped by the device they are on and at most
+// ioConcurrencyPerDevice files of one device are read at the same time.
+// With io_uring, one worker per device reads its small files in batches through one deep
+// ring instead, with at most ioConcurrencyPerDevice reads in flight, and the others file
+// by file.
+
+class FileHashService
+{
+    Q_DISABLE_COPY_MOVE(FileHashService)
+public:
+    // only the first entity of each inode in inodeGroups is hashed. the caller shares
+    // its results with the others. inodeGroups is used only in the constructor.
+    FileHashService(const EntityList &entities, const Path::InodeGroups *inodeGroups,
+                    QList<FileHash::Algorithm> algorithms, int ioConcurrencyPerDevice,
+                    bool isIoUringEnabled = false);
+    ~FileHashService();
+
+    void start();
+    void cancel();
+
+    // blocks until the hashes of entities[index] are set to the entity, failed or canceled.
+    void waitForEntity(qsizetype index);
+
+    static int ioConcurrencyPerDevice();
+    static bool isIoUringEnabled();
+
+private:
+    struct DeviceQueue {
+        QList<qsizetype> indices;
+        std::atomic<qsizetype> next = 0;
+    };
+
+    void hashEntities(DeviceQueue *queue);
+    bool hashEntitiesInBatches(DeviceQueue *queue);
+    QList<FileHash::Algorithm> missingAlgorithms(qsizetype index) const;
+    void setDone(qsizetype index);
+
+    const EntityList m_entities;
+    const QList<FileHash::Algorithm> m_algorithms;
+    const int m_ioConcurrencyPerDevice;
+    const bool m_isIoUringEnabled;
+
+    std::vector<std::unique_ptr<DeviceQueue>> m_queues;
+    std::atomic_bool m_isCanceled = false;
+
+    QMutex m_mutex;
+    QWaitCondition m_doneCondition;
+    QList<bool> m_isDone;
+
+    QThreadPool m_threadPool;
+};
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filehashstatistics.h"
+
+#include <QDateTime>
+
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <time.h>
+#else
+#include <QElapsedTimer>
+#endif
+
+namespace {
+
+Q_GLOBAL_STATIC(FileHashStatistics, fileHashStatistics)
+
+qint64 percentile(std::vector<qint64> &samples, int percent)
+{
+    if (samples.empty())
+        return 0;
+
+    const auto nth = samples.begin() + qsizetype(samples.size() - 1) * percent / 100;
+
+    std::nth_element(samples.begin(), nth, samples.end());
+
+    return *nth;
+}
+
+} // anonymous
+
+FileHashStatistics &FileHashStatistics::instance()
+{
+    return *fileHashStatistics;
+}
+
+qint64 FileHashStatistics::threadCpuTimeNs()
+{
+#ifdef Q_OS_UNIX
+    timespec time;
+
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0)
+        return qint64(time.tv_sec) * 1000000000 + time.tv_nsec;
+
+    return 0;
+#else
+    // no per-thread CPU clock here. wall time is the closest substitute.
+    static const QElapsedTimer timer = []() {
+        QElapsedTimer startedTimer;
+
+        startedTimer.start();
+
+        return startedTimer;
+    }();
+
+    return timer.nsecsElapsed();
+#endif
+}
+
+void FileHashStatistics::addFile(qint64 bytes, qint64 latencyNs)
+{
+    m_bytesRead += bytes;
+    ++m_filesHashed;
+    m_wallTimeNs += latencyNs;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_latencySamples.size() < latencySampleCount) {
+        m_latencySamples.push_back(latencyNs);
+        return;
+    }
+
+    m_latencySamples[m_nextLatencySample] = latencyNs;
+    m_nextLatencySample = (m_nextLatencySample + 1) % latencySampleCount;
+}
+
+void FileHashStatistics::addCpuTime(FileHash::Algorithm algorithm, qint64 cpuTimeNs)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_cpuTimeNs[algorithm] += cpuTimeNs;
+}
+
+void FileHashStatistics::addQueueDepth(qint64 delta)
+{
+    const qint64 depth = (m_queueDepth += delta);
+    qint64 maxDepth = m_maxQueueDepth;
+
+    while (depth > maxDepth && !m_maxQueueDepth.compare_exchange_weak(maxDepth, depth)) {}
+}
+
+void FileHashStatistics::reset()
+{
+    m_bytesRead = 0;
+    m_filesHashed = 0;
+    m_wallTimeNs = 0;
+    m_maxQueueDepth = m_queueDepth.load();
+
+    QMutexLocker locker(&m_mutex);
+
+    m_cpuTimeNs.clear();
+    m_latencySamples.clear();
+    m_nextLatencySample = 0;
+}
+
+FileHashStatistics::Snapshot FileHashStatistics::snapshot() const
+{
+    Snapshot result;
+
+    result.bytesRead = m_bytesRead;
+    result.filesHashed = m_filesHashed;
+    result.wallTimeNs = m_wallTimeNs;
+    result.queueDepth = m_queueDepth;
+    result.maxQueueDepth = m_maxQueueDepth;
+
+    m_mutex.lock();
+
+    result.cpuTimeNs = m_cpuTimeNs;
+    std::vector<qint64> samples = m_latencySamples;
+
+    m_mutex.unlock();
+
+    result.latencyP50Ns = percentile(samples, 50);
+    result.latencyP99Ns = percentile(samples, 99);
+
+    return result;
+}
+
+QJsonObject FileHashStatistics::toJson(const Snapshot &snapshot)
+{
+    QJsonObject cpuTimes;
+
+    for (auto itr = snapshot.cpuTimeNs.cbegin(), end = snapshot.cpuTimeNs.cend(); itr != end; ++itr)
+        cpuTimes.insert(FileHash::algorithmName(itr.key()), itr.value());
+
+    return QJsonObject{
+        {QStringLiteral("timestamp"), QDateTime::currentDateTime().toString(Qt::ISODate)},
+        {QStringLiteral("bytesRead"), snapshot.bytesRead},
+        {QStringLiteral("filesHashed"), snapshot.filesHashed},
+        {QStringLiteral("wallTimeNs"), snapshot.wallTimeNs},
+        {QStringLiteral("cpuTimeNs"), cpuTimes},
+        {QStringLiteral("queueDepth"), snapshot.queueDepth},
+        {QStringLiteral("maxQueueDepth"), snapshot.maxQueueDepth},
+        {QStringLiteral("latencyP50Ns"), snapshot.latencyP50Ns},
+        {QStringLiteral("latencyP99Ns"), snapshot.latencyP99Ns},
+    };
+}
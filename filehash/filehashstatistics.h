@@ -0,0 +1,77 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "filehashalgorithm.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+
+#include <atomic>
+#include <vector>
+
+// Counters of the file hashing path, to tell disk-bound runs from CPU-bound ones.
+// Every member is thread safe.
+class FileHashStatistics
+{
+    Q_DISABLE_COPY_MOVE(FileHashStatistics)
+public:
+    struct Snapshot {
+        qint64 bytesRead = 0;
+        qint64 filesHashed = 0;
+        qint64 wallTimeNs = 0; // sum of per-file latencies
+        QHash<FileHash::Algorithm, qint64> cpuTimeNs;
+        qint64 queueDepth = 0;
+        qint64 maxQueueDepth = 0;
+        qint64 latencyP50Ns = 0;
+        qint64 latencyP99Ns = 0;
+    };
+
+    FileHashStatistics() = default;
+
+    static FileHashStatistics &instance();
+
+    // CPU time of the calling thread.
+    static qint64 threadCpuTimeNs();
+
+    void addFile(qint64 bytes, qint64 latencyNs);
+    void addCpuTime(FileHash::Algorithm algorithm, qint64 cpuTimeNs);
+    void addQueueDepth(qint64 delta);
+
+    void reset();
+    Snapshot snapshot() const;
+
+    static QJsonObject toJson(const Snapshot &snapshot);
+
+private:
+    static constexpr size_t latencySampleCount = 1 << 16;
+
+    std::atomic<qint64> m_bytesRead = 0;
+    std::atomic<qint64> m_filesHashed = 0;
+    std::atomic<qint64> m_wallTimeNs = 0;
+    std::atomic<qint64> m_queueDepth = 0;
+    std::atomic<qint64> m_maxQueueDepth = 0;
+
+    mutable QMutex m_mutex;
+    QHash<FileHash::Algorithm, qint64> m_cpuTimeNs;
+    std::vector<qint64> m_latencySamples; // the latest latencySampleCount files
+    size_t m_nextLatencySample = 0;
+};
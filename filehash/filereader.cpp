@@ -0,0 +1,175 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "filereader.h"
+
+#include <QFile>
+
+#include <memory>
+#include <new>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef Q_OS_UNIX
+
+constexpr std::align_val_t bufferAlignment{4096};
+
+struct AlignedDeleter {
+    void operator()(char *buffer) const { ::operator delete[](buffer, bufferAlignment); }
+};
+
+void adviseSequential(int fd)
+{
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#else
+    Q_UNUSED(fd)
+#endif
+}
+
+void adviseDontNeed(int fd, qint64 offset, qint64 length)
+{
+#ifdef POSIX_FADV_DONTNEED
+    ::posix_fadvise(fd, off_t(offset), off_t(length), POSIX_FADV_DONTNEED);
+#else
+    Q_UNUSED(fd) Q_UNUSED(offset) Q_UNUSED(length)
+#endif
+}
+
+bool readBuffered(int fd, const FileReader::Consumer &consume)
+{
+    std::unique_ptr<char[], AlignedDeleter> buffer(
+                new (bufferAlignment) char[FileReader::bufferSize]);
+
+    qint64 offset = 0;
+
+    forever {
+        const ssize_t readSize = ::pread(fd, buffer.get(), size_t(FileReader::bufferSize),
+                                         off_t(offset));
+        if (readSize == 0)
+            return true;
+
+        if (readSize < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        consume(QByteArrayView{buffer.get(), qsizetype(readSize)});
+        adviseDontNeed(fd, offset, readSize);
+
+        offset += readSize;
+    }
+}
+
+bool readMemoryMapped(int fd, qint64 fileSize, const FileReader::Consumer &consume)
+{
+    void *mapped = ::mmap(nullptr, size_t(fileSize), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if (mapped == MAP_FAILED)
+        return readBuffered(fd, consume);
+
+    ::madvise(mapped, size_t(fileSize), MADV_SEQUENTIAL);
+
+    char *data = static_cast<char *>(mapped);
+    constexpr qint64 chunkSize = FileReader::bufferSize * 8; // a multiple of the page size
+
+    // mapped pages are not dropped from the cache. each chunk is unmapped before the advice
+    for (qint64 offset = 0; offset < fileSize; offset += chunkSize) {
+        const qint64 length = qMin(chunkSize, fileSize - offset);
+
+        consume(QByteArrayView{data + offset, qsizetype(length)});
+
+        ::munmap(data + offset, size_t(length));
+        adviseDontNeed(fd, offset, length);
+    }
+
+    return true;
+}
+
+#endif // Q_OS_UNIX
+
+} // anonymous
+
+FileReader::FileReader(QStringView filePath, Strategy strategy)
+    : m_filePath(filePath.toString()),
+      m_strategy(strategy)
+{
+}
+
+bool FileReader::read(const Consumer &consume) const
+{
+#ifdef Q_OS_UNIX
+    const int fd = ::open(QFile::encodeName(m_filePath).constData(), O_RDONLY | O_CLOEXEC);
+
+    if (fd == -1)
+        return false;
+
+    struct stat status;
+
+    if (::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    adviseSequential(fd);
+
+    const qint64 fileSize = status.st_size;
+    const bool isMemoryMapped = (m_strategy == Strategy::MemoryMapped);
+
+    const bool isOk = (isMemoryMapped && fileSize > 0) ? readMemoryMapped(fd, fileSize, consume)
+                                                       : readBuffered(fd, consume);
+    ::close(fd);
+
+    return isOk;
+#else
+    return readByQFile(consume);
+#endif
+}
+
+bool FileReader::readByQFile(const Consumer &consume) const
+{
+    QFile file(m_filePath);
+
+    if (!file.open(QFile::ReadOnly | QFile::Unbuffered))
+        return false;
+
+    QByteArray buffer(bufferSize, Qt::Uninitialized);
+
+    forever {
+        const qint64 readSize = file.read(buffer.data(), buffer.size());
+
+        if (readSize == 0)
+            return true;
+
+        if (readSize < 0)
+            return false;
+
+        consume(QByteArrayView{buffer.constData(), qsizetype(readSize)});
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+
+#if defined(Q_OS_LINUX) && __has_include(<linux/io_uring.h>)
+#define FILEHASH_HAS_IO_URING
+#endif
+
+// Reads many small files through openat, read and close requests on one io_uring.
+// The ring keeps up to queueDepth requests in flight, and the steps of different files
+// overlap. Only reads are limited, to maxReadsInFlight, the concurrency of the device.
+// Only regular files that fit in smallFileSize are opened, and only a read of exactly
+// their size is complete. The caller reads the others by FileReader.
+// Talks to the kernel directly so that liburing is not needed.
+class UringBatchReader
+{
+    Q_DISABLE_COPY_MOVE(UringBatchReader)
+public:
+    struct Request {
+        QByteArray encodedPath;
+        QByteArray content;
+        bool isComplete = false; // false if the file could not be read whole or is larger
+    };
+
+    static constexpr qsizetype smallFileSize = 256 * 1024;
+
+    UringBatchReader(unsigned queueDepth, int maxReadsInFlight);
+    ~UringBatchReader();
+
+    // false if the kernel does not provide io_uring or the ring has failed.
+    bool isValid() const;
+    unsigned queueDepth() const;
+
+    static bool isSupported();
+
+    // any number of requests. nothing is complete once the ring failed.
+    void read(QList<Request> &requests);
+
+private:
+    struct Ring;
+
+    Ring *m_ring = nullptr;
+    int m_maxReadsInFlight = 1;
+};
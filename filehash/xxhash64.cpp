@@ -0,0 +1,139 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "xxhash64.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace {
+
+constexpr quint64 prime1 = 0x9E3779B185EBCA87ULL;
+constexpr quint64 prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr quint64 prime3 = 0x165667B19E3779F9ULL;
+constexpr quint64 prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr quint64 prime5 = 0x27D4EB2F165667C5ULL;
+
+constexpr quint64 rotateLeft(quint64 value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+constexpr quint64 round(quint64 accumulator, quint64 input)
+{
+    return rotateLeft(accumulator + input * prime2, 31) * prime1;
+}
+
+constexpr quint64 mergeRound(quint64 accumulator, quint64 value)
+{
+    return (accumulator ^ round(0, value)) * prime1 + prime4;
+}
+
+} // anonymous
+
+XxHash64::XxHash64()
+    : m_accumulators{prime1 + prime2, prime2, 0, 0 - prime1}
+{
+}
+
+void XxHash64::addData(QByteArrayView data)
+{
+    auto bytes = reinterpret_cast<const uchar *>(data.data());
+    qsizetype size = data.size();
+
+    m_totalSize += quint64(size);
+
+    if (m_bufferSize > 0) {
+        const qsizetype fill = qMin(qsizetype(m_buffer.size()) - m_bufferSize, size);
+
+        std::memcpy(m_buffer.data() + m_bufferSize, bytes, size_t(fill));
+        m_bufferSize += fill;
+        bytes += fill;
+        size -= fill;
+
+        if (m_bufferSize < qsizetype(m_buffer.size()))
+            return;
+
+        consumeStripe(m_buffer.data());
+        m_bufferSize = 0;
+    }
+
+    for (; size >= qsizetype(m_buffer.size()); size -= m_buffer.size(), bytes += m_buffer.size())
+        consumeStripe(bytes);
+
+    std::memcpy(m_buffer.data(), bytes, size_t(size));
+    m_bufferSize = size;
+}
+
+QByteArray XxHash64::result() const
+{
+    QByteArray digest(sizeof(quint64), Qt::Uninitialized);
+
+    qToBigEndian<quint64>(value(), digest.data());
+
+    return digest;
+}
+
+quint64 XxHash64::value() const
+{
+    quint64 hash = 0;
+
+    if (m_totalSize >= m_buffer.size()) {
+        hash = rotateLeft(m_accumulators[0], 1) + rotateLeft(m_accumulators[1], 7)
+               + rotateLeft(m_accumulators[2], 12) + rotateLeft(m_accumulators[3], 18);
+
+        for (quint64 accumulator : m_accumulators)
+            hash = mergeRound(hash, accumulator);
+    } else {
+        hash = prime5;
+    }
+
+    hash += m_totalSize;
+
+    const uchar *tail = m_buffer.data();
+    qsizetype size = m_bufferSize;
+
+    for (; size >= 8; size -= 8, tail += 8)
+        hash = rotateLeft(hash ^ round(0, qFromLittleEndian<quint64>(tail)), 27) * prime1 + prime4;
+
+    if (size >= 4) {
+        hash = rotateLeft(hash ^ (quint64(qFromLittleEndian<quint32>(tail)) * prime1), 23) * prime2
+               + prime3;
+        size -= 4;
+        tail += 4;
+    }
+
+    for (; size > 0; --size, ++tail)
+        hash = rotateLeft(hash ^ (*tail * prime5), 11) * prime1;
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+void XxHash64::consumeStripe(const uchar *stripe)
+{
+    for (size_t i = 0; i < m_accumulators.size(); ++i)
+        m_accumulators[i] = round(m_accumulators[i], qFromLittleEndian<quint64>(stripe + i * 8));
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+#include <array>
+
+// XXH64 with seed 0. The result is the canonical (big endian) form.
+class XxHash64
+{
+public:
+    XxHash64();
+
+    void addData(QByteArrayView data);
+    QByteArray result() const;
+    quint64 value() const; // the result as a number
+
+private:
+    void consumeStripe(const uchar *stripe);
+
+    std::array<quint64, 4> m_accumulators;
+    std::array<uchar, 32> m_buffer;
+    qsizetype m_bufferSize = 0;
+    quint64 m_totalSize = 0;
+};
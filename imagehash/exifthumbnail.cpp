@@ -0,0 +1,194 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "exifthumbnail.h"
+#include "jpegsegmentreader.h"
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QtEndian>
+
+#include <optional>
+
+namespace {
+
+namespace Tag {
+constexpr quint16 jpegInterchangeFormat = 0x0201;
+constexpr quint16 jpegInterchangeFormatLength = 0x0202;
+} // Tag
+
+namespace Type {
+constexpr quint16 shortType = 3;
+constexpr quint16 longType = 4;
+} // Type
+
+constexpr QByteArrayView exifHeader("Exif\0\0", 6);
+constexpr qsizetype ifdEntrySize = 12;
+
+// reads the TIFF structure of the Exif payload. every offset is from the TIFF header.
+class TiffReader
+{
+public:
+    explicit TiffReader(QByteArrayView tiff)
+        : m_tiff(tiff),
+          m_isLittleEndian(tiff.startsWith("II"))
+    {
+    }
+
+    bool isValid() const
+    {
+        return (m_tiff.startsWith("II") || m_tiff.startsWith("MM")) && uint16(2) == 42;
+    }
+
+    std::optional<quint16> uint16(qsizetype offset) const
+    {
+        if (offset < 0 || offset + 2 > m_tiff.size())
+            return std::nullopt;
+
+        const uchar *data = reinterpret_cast<const uchar *>(m_tiff.data()) + offset;
+
+        return m_isLittleEndian ? qFromLittleEndian<quint16>(data) : qFromBigEndian<quint16>(data);
+    }
+
+    std::optional<quint32> uint32(qsizetype offset) const
+    {
+        if (offset < 0 || offset + 4 > m_tiff.size())
+            return std::nullopt;
+
+        const uchar *data = reinterpret_cast<const uchar *>(m_tiff.data()) + offset;
+
+        return m_isLittleEndian ? qFromLittleEndian<quint32>(data) : qFromBigEndian<quint32>(data);
+    }
+
+    // the offset of the IFD after the IFD at ifdOffset. 0 if it is the last one.
+    std::optional<quint32> nextIfd(quint32 ifdOffset) const
+    {
+        const std::optional<quint16> entryCount = uint16(ifdOffset);
+
+        if (!entryCount.has_value())
+            return std::nullopt;
+
+        return uint32(qsizetype(ifdOffset) + 2 + *entryCount * ifdEntrySize);
+    }
+
+    // the value of a SHORT or LONG tag with a count of 1.
+    std::optional<quint32> value(quint32 ifdOffset, quint16 tag) const
+    {
+        const std::optional<quint16> entryCount = uint16(ifdOffset);
+
+        if (!entryCount.has_value())
+            return std::nullopt;
+
+        for (int i = 0; i < *entryCount; ++i) {
+            const qsizetype entry = qsizetype(ifdOffset) + 2 + i * ifdEntrySize;
+
+            if (uint16(entry) != tag)
+                continue;
+
+            const std::optional<quint16> type = uint16(entry + 2);
+
+            if (type == Type::longType)
+                return uint32(entry + 8);
+
+            if (type == Type::shortType)
+                return uint16(entry + 8);
+
+            return std::nullopt;
+        }
+
+        return std::nullopt;
+    }
+
+    QByteArrayView data(quint32 offset, quint32 length) const
+    {
+        if (qsizetype(offset) + length > m_tiff.size())
+            return QByteArrayView{};
+
+        return m_tiff.sliced(offset, length);
+    }
+
+private:
+    const QByteArrayView m_tiff;
+    const bool m_isLittleEndian;
+};
+
+QByteArray thumbnailFromTiff(QByteArrayView tiff)
+{
+    const TiffReader reader(tiff);
+
+    if (!reader.isValid())
+        return QByteArray{};
+
+    const std::optional<quint32> ifd0 = reader.uint32(4);
+
+    if (!ifd0.has_value())
+        return QByteArray{};
+
+    const std::optional<quint32> ifd1 = reader.nextIfd(*ifd0);
+
+    if (!ifd1.has_value() || *ifd1 == 0)
+        return QByteArray{};
+
+    const std::optional<quint32> offset = reader.value(*ifd1, Tag::jpegInterchangeFormat);
+    const std::optional<quint32> length = reader.value(*ifd1, Tag::jpegInterchangeFormatLength);
+
+    if (!offset.has_value() || !length.has_value())
+        return QByteArray{};
+
+    const QByteArrayView thumbnail = reader.data(*offset, *length);
+
+    if (!thumbnail.startsWith("\xff\xd8")) // a TIFF thumbnail is not supported
+        return QByteArray{};
+
+    return thumbnail.toByteArray();
+}
+
+} // anonymous
+
+namespace Exif {
+
+QByteArray thumbnail(const QString &filePath)
+{
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray{};
+
+    JpegSegmentReader reader(&file);
+
+    if (!reader.start())
+        return QByteArray{};
+
+    // Exif is normally the first segment. an APP1 segment may also hold XMP.
+    while (reader.next()) {
+        if (reader.marker() != JpegSegmentReader::app1Marker)
+            continue;
+
+        const QByteArray segment = reader.read(reader.length());
+
+        if (segment.size() != reader.length())
+            return QByteArray{};
+
+        if (segment.startsWith(exifHeader))
+            return thumbnailFromTiff(QByteArrayView(segment).sliced(exifHeader.size()));
+    }
+
+    return QByteArray{};
+}
+
+} // Exif
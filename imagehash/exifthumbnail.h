@@ -0,0 +1,31 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+namespace Exif {
+
+// The JPEG thumbnail in IFD1 of the Exif APP1 segment, read without decoding the image.
+// empty if the file is not a JPEG, has no Exif or has no JPEG thumbnail.
+// the APP1 segment is at most 64 KiB, so the thumbnail is too.
+QByteArray thumbnail(const QString &filePath);
+
+} // Exif
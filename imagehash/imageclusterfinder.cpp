@@ -0,0 +1,149 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "imageclusterfinder.h"
+#include "multiindexhash.h"
+#include "path/pathentity.h"
+
+#include <QtConcurrent>
+
+#include <numeric>
+
+namespace {
+
+class DisjointSet
+{
+public:
+    explicit DisjointSet(qsizetype size)
+        : m_parents(size_t(size))
+    {
+        std::iota(m_parents.begin(), m_parents.end(), 0);
+    }
+
+    qsizetype find(qsizetype element)
+    {
+        while (m_parents[size_t(element)] != element) {
+            m_parents[size_t(element)] = m_parents[size_t(m_parents[size_t(element)])];
+            element = m_parents[size_t(element)];
+        }
+
+        return element;
+    }
+
+    void unite(qsizetype lhs, qsizetype rhs)
+    {
+        lhs = find(lhs);
+        rhs = find(rhs);
+
+        if (lhs != rhs)
+            m_parents[size_t(qMax(lhs, rhs))] = qMin(lhs, rhs);
+    }
+
+private:
+    std::vector<qsizetype> m_parents;
+};
+
+} // anonymous
+
+ImageClusterFinder::ImageClusterFinder(const EntityList &entities,
+                                       PerceptualHash::Algorithm algorithm, int threshold)
+    : m_entities(entities),
+      m_algorithm(algorithm),
+      m_threshold(qBound(0, threshold, maxThreshold))
+{
+}
+
+QList<ImageClusterFinder::Cluster> ImageClusterFinder::find(const std::function<bool()> &isCanceled)
+{
+    QList<Cluster> clusters(m_entities.size());
+
+    // identical hashes share a node of the index
+    MultiIndexHash index(m_threshold, m_entities.size());
+    std::vector<qsizetype> nodeOfEntity(size_t(m_entities.size()), -1);
+
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i) {
+        const std::optional<quint64> hash = m_entities.at(i)->imageHash(m_algorithm);
+
+        if (hash.has_value())
+            nodeOfEntity[size_t(i)] = index.insert(*hash);
+    }
+
+    std::vector<quint64> nodeValues(size_t(index.size()));
+
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i) {
+        if (nodeOfEntity[size_t(i)] != -1)
+            nodeValues[size_t(nodeOfEntity[size_t(i)])] = *m_entities.at(i)->imageHash(m_algorithm);
+    }
+
+    // the queries are independent. each keeps the neighbours after itself only
+    std::vector<std::vector<qsizetype>> neighbours(size_t(index.size()));
+    std::vector<qsizetype> nodes(size_t(index.size()));
+
+    std::iota(nodes.begin(), nodes.end(), 0);
+
+    QtConcurrent::blockingMap(nodes, [&](qsizetype node) {
+        if (isCanceled())
+            return;
+
+        std::vector<qsizetype> &found = neighbours[size_t(node)];
+
+        index.query(nodeValues[size_t(node)], [&found, node](qsizetype other) {
+            if (other > node)
+                found.push_back(other);
+        });
+    });
+
+    if (isCanceled())
+        return clusters;
+
+    DisjointSet linkedNodes(index.size());
+
+    for (qsizetype node = 0, count = index.size(); node < count; ++node) {
+        for (qsizetype other : neighbours[size_t(node)])
+            linkedNodes.unite(node, other);
+    }
+
+    // numbered in the order of the entities
+    std::vector<qsizetype> entityCounts(size_t(index.size()), 0);
+
+    for (qsizetype node : nodeOfEntity) {
+        if (node != -1)
+            ++entityCounts[size_t(linkedNodes.find(node))];
+    }
+
+    std::vector<int> clusterIds(size_t(index.size()), 0);
+    std::vector<int> memberCounts(size_t(index.size()), 0);
+    int clusterCount = 0;
+
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i) {
+        if (nodeOfEntity[size_t(i)] == -1)
+            continue;
+
+        const qsizetype root = linkedNodes.find(nodeOfEntity[size_t(i)]);
+
+        if (entityCounts[size_t(root)] < 2)
+            continue;
+
+        if (clusterIds[size_t(root)] == 0)
+            clusterIds[size_t(root)] = ++clusterCount;
+
+        clusters[i] = Cluster{clusterIds[size_t(root)], ++memberCounts[size_t(root)]};
+    }
+
+    return clusters;
+}
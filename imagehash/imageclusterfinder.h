@@ -0,0 +1,53 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "imagehashalgorithm.h"
+#include "path/usingpathentity.h"
+
+#include <functional>
+
+// Clusters visually similar images. Images are linked when the Hamming distance of their
+// hashes is within the threshold, and a cluster is a connected set of links. The neighbours
+// are looked up by multi-index hashing, which stays below n^2 comparisons only while the
+// threshold is small against the 64 bits. The threshold is capped at maxThreshold, with
+// which a query of 500k images looks up parts within 2 bits and compares about 1% of them.
+// Links chain, so two images of a cluster may be farther apart than the threshold.
+class ImageClusterFinder
+{
+public:
+    struct Cluster {
+        int id = 0;     // from 1 in the order of the entities. 0 if not clustered
+        int member = 0; // from 1 in the order of the entities within the cluster
+    };
+
+    static constexpr int maxThreshold = 10;
+
+    ImageClusterFinder(const EntityList &entities, PerceptualHash::Algorithm algorithm,
+                       int threshold);
+
+    // the image hashes of the algorithm must be set to the entities beforehand.
+    // entities without the hash and images without any similar image are not clustered.
+    QList<Cluster> find(const std::function<bool()> &isCanceled);
+
+private:
+    const EntityList &m_entities;
+    const PerceptualHash::Algorithm m_algorithm;
+    const int m_threshold;
+};
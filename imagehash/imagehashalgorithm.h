@@ -0,0 +1,35 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QString>
+
+namespace PerceptualHash {
+
+// Every algorithm gives a 64-bit hash. values are saved in settings.
+enum class Algorithm : int {
+    Difference, // dHash. gradients of 9x8
+    Average,    // aHash. 8x8 against the mean
+    Dct,        // pHash. low frequencies of the 32x32 DCT against their median
+    Wavelet,    // wHash. Haar LL band of 64x64 against its median
+};
+
+QString algorithmName(Algorithm algorithm);
+
+} // PerceptualHash
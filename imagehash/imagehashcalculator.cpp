@@ -18,42 +18,320 @@
  */
 
 #include "imagehashcalculator.h"
+#include "exifthumbnail.h"
 
-#include <QImage>
-#include <QDebug>
+#include <QBuffer>
+#include <QImageReader>
+#include <QtEndian>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr quint64 reverseBits(quint64 value)
+{
+    value = ((value >> 1) & 0x5555555555555555) | ((value & 0x5555555555555555) << 1);
+    value = ((value >> 2) & 0x3333333333333333) | ((value & 0x3333333333333333) << 2);
+    value = ((value >> 4) & 0x0f0f0f0f0f0f0f0f) | ((value & 0x0f0f0f0f0f0f0f0f) << 4);
+
+    return qbswap(value);
+}
+
+// image is 9x8 Grayscale8. bit (63 - (y * 8 + x)) is set if pixel (x, y) is not darker
+// than its right neighbour, so the hex of the value reads row by row from the top left.
+quint64 differenceHash(const QImage &image)
+{
+    Q_ASSERT(image.format() == QImage::Format_Grayscale8);
+    Q_ASSERT(image.width() == 9 && image.height() == 8);
+
+    // bit (y * 8 + x) first. reversed at the end
+    quint64 bits = 0;
+
+#ifdef __SSE2__
+    // two rows per step. a row has 9 pixels, so both loads stay in the row.
+    for (int y = 0; y < 8; y += 2) {
+        const uchar *upper = image.constScanLine(y);
+        const uchar *lower = image.constScanLine(y + 1);
+
+        auto load = [](const uchar *pixels) {
+            return _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pixels));
+        };
+
+        const __m128i lhs = _mm_unpacklo_epi64(load(upper), load(lower));
+        const __m128i rhs = _mm_unpacklo_epi64(load(upper + 1), load(lower + 1));
+        const __m128i isNotDarker = _mm_cmpeq_epi8(_mm_max_epu8(lhs, rhs), lhs);
+
+        bits |= quint64(quint16(_mm_movemask_epi8(isNotDarker))) << (y * 8);
+    }
+#else
+    for (int y = 0; y < 8; ++y) {
+        const uchar *pixels = image.constScanLine(y);
+
+        for (int x = 0; x < 8; ++x) {
+            if (pixels[x] >= pixels[x + 1])
+                bits |= quint64(1) << (y * 8 + x);
+        }
+    }
+#endif
+
+    return reverseBits(bits);
+}
+
+// the threshold of the hashes below. the mean of the two middle values.
+template <typename T>
+float median(std::array<T, 64> values)
+{
+    const auto middle = values.begin() + 32;
+
+    std::nth_element(values.begin(), middle, values.end());
+
+    const T upper = *middle;
+    const T lower = *std::max_element(values.begin(), middle);
+
+    return (float(lower) + float(upper)) / 2;
+}
+
+// bit (63 - i) is set if values[i] is greater than the threshold.
+template <typename T>
+quint64 bitsAbove(const std::array<T, 64> &values, float threshold)
+{
+    quint64 bits = 0;
+
+    for (T value : values)
+        bits = (bits << 1) | quint64(float(value) > threshold);
+
+    return bits;
+}
+
+// image is 8x8 Grayscale8.
+quint64 averageHash(const QImage &image)
+{
+    std::array<int, 64> pixels;
+    int sum = 0;
+
+    for (int y = 0; y < 8; ++y) {
+        const uchar *line = image.constScanLine(y);
+
+        for (int x = 0; x < 8; ++x) {
+            pixels[size_t(y * 8 + x)] = line[x];
+            sum += line[x];
+        }
+    }
+
+    return bitsAbove(pixels, float(sum) / 64);
+}
+
+using DctTable = std::array<std::array<float, 8>, 32>;
+
+// cosines of the DCT-II of 32 samples for the 8 lowest frequencies, as [sample][frequency].
+// the frequency is the inner index, so both passes below are 8-wide multiply-adds
+// which the compiler vectorizes without reordering any sum.
+const DctTable &dctTable()
+{
+    static const DctTable table = []() {
+        DctTable cosines;
+
+        for (int n = 0; n < 32; ++n) {
+            for (int k = 0; k < 8; ++k)
+                cosines[n][k] = float(std::cos(std::numbers::pi * (2 * n + 1) * k / 64));
+        }
+
+        return cosines;
+    }();
+
+    return table;
+}
+
+// image is 32x32 Grayscale8. the constant factors of the DCT do not change the bits.
+quint64 dctHash(const QImage &image)
+{
+    const DctTable &cosines = dctTable();
+
+    // horizontal pass. only the 8 lowest frequencies of each row are needed
+    std::array<std::array<float, 8>, 32> rows{};
+
+    for (int y = 0; y < 32; ++y) {
+        const uchar *line = image.constScanLine(y);
+
+        for (int n = 0; n < 32; ++n) {
+            const float pixel = line[n];
+
+            for (int k = 0; k < 8; ++k)
+                rows[y][k] += pixel * cosines[n][k];
+        }
+    }
+
+    // vertical pass
+    std::array<float, 64> coefficients{};
+
+    for (int y = 0; y < 32; ++y) {
+        for (int v = 0; v < 8; ++v) {
+            const float cosine = cosines[y][v];
+
+            for (int k = 0; k < 8; ++k)
+                coefficients[size_t(v * 8 + k)] += cosine * rows[y][k];
+        }
+    }
+
+    return bitsAbove(coefficients, median(coefficients));
+}
+
+// image is 64x64 Grayscale8. after three levels of the Haar transform, the LL band is
+// the sum of each 8x8 block up to a constant factor, so the blocks are summed directly.
+quint64 waveletHash(const QImage &image)
+{
+    std::array<int, 64> lowBand{};
+
+    for (int y = 0; y < 64; ++y) {
+        const uchar *line = image.constScanLine(y);
+        int *blocks = lowBand.data() + (y / 8) * 8;
+
+        for (int x = 0; x < 64; ++x)
+            blocks[x / 8] += line[x];
+    }
+
+    return bitsAbove(lowBand, median(lowBand));
+}
+
+QSize sampleSize(PerceptualHash::Algorithm algorithm)
+{
+    switch (algorithm) {
+    case PerceptualHash::Algorithm::Difference:
+        return QSize(9, 8);
+    case PerceptualHash::Algorithm::Average:
+        return QSize(8, 8);
+    case PerceptualHash::Algorithm::Dct:
+        return QSize(32, 32);
+    case PerceptualHash::Algorithm::Wavelet:
+        return QSize(64, 64);
+    }
+
+    return QSize{};
+}
+
+} // anonymous
 
 ImageHashCalculator::ImageHashCalculator(QStringView filePath)
     : m_filePath(filePath.toString())
 {
 }
 
-QString ImageHashCalculator::resultString()
+ImageHashCalculator::~ImageHashCalculator() = default;
+
+std::optional<quint64> ImageHashCalculator::result(PerceptualHash::Algorithm algorithm)
+{
+    // takes the reader of the estimate. the next algorithm reads the file again
+    reader();
+
+    const std::unique_ptr<QImageReader> imageReader = std::move(m_reader);
+
+    return hash(scaledImage(*imageReader, sampleSize(algorithm)), algorithm);
+}
+
+std::optional<quint64> ImageHashCalculator::thumbnailResult(PerceptualHash::Algorithm algorithm)
 {
-    QImage imageOrigin{m_filePath};
+    if (!m_exifThumbnail.has_value())
+        m_exifThumbnail = Exif::thumbnail(m_filePath);
 
-    if (imageOrigin.isNull())
-        return QString{};
+    if (m_exifThumbnail->isEmpty())
+        return std::nullopt;
 
-    QImage image = imageOrigin.scaled(9, 8).convertToFormat(QImage::Format_Grayscale8);
+    QBuffer buffer(&*m_exifThumbnail);
 
-    QString result;
-    QString binary;
+    buffer.open(QIODevice::ReadOnly);
 
-    for (int y = 0; y < 8; ++y) {
-        for (int margin = 0; margin < 5; margin += 4) {
-            for (int x = 0; x < 4; ++x) {
-                int lhs = qGray(image.pixel(x + margin, y));
-                int rhs = qGray(image.pixel(x + margin + 1, y));
+    QImageReader reader(&buffer, "jpeg");
 
-                binary += (lhs < rhs) ? "0" : "1";
-            }
+    return hash(scaledImage(reader, sampleSize(algorithm)), algorithm);
+}
+
+qint64 ImageHashCalculator::decodeMemoryEstimate(PerceptualHash::Algorithm algorithm)
+{
+    QImageReader &reader = this->reader();
+
+    if (!reader.canRead())
+        return 0;
+
+    const QSize fullSize = reader.size();
+    const QSize size = sampleSize(algorithm);
+
+    if (!fullSize.isValid())
+        return unknownSizeMemoryEstimate;
+
+    QSize decodedSize = fullSize;
 
-            int fourBit = binary.toInt(nullptr, 2);
+    // the JPEG decoder scales by the smallest of 1/8, 1/4 and 1/2 that is not below the size.
+    if (reader.format() == "jpeg") {
+        for (int denominator = 8; denominator > 1; denominator /= 2) {
+            const QSize scaledSize((fullSize.width() + denominator - 1) / denominator,
+                                   (fullSize.height() + denominator - 1) / denominator);
 
-            result += QString::number(fourBit, 16);
-            binary.clear();
+            if (scaledSize.width() >= size.width() && scaledSize.height() >= size.height()) {
+                decodedSize = scaledSize;
+                break;
+            }
         }
     }
 
-    return result;
+    constexpr qint64 bytesPerPixel = 4;
+
+    return (qint64(decodedSize.width()) * decodedSize.height()
+            + qint64(size.width()) * size.height()) * bytesPerPixel;
+}
+
+QImageReader &ImageHashCalculator::reader()
+{
+    if (m_reader == nullptr)
+        m_reader = std::make_unique<QImageReader>(m_filePath);
+
+    return *m_reader;
+}
+
+QImage ImageHashCalculator::scaledImage(QImageReader &reader, QSize size)
+{
+    // JPEG decodes at 1/2, 1/4 or 1/8 of the size in the DCT and smooth-scales the rest,
+    // so the full resolution image never exists. other formats are scaled by QImageReader
+    // right after decoding.
+    reader.setScaledSize(size);
+
+    // lets JPEG use the fast integer DCT and skip fancy upsampling. invisible at this size.
+    reader.setQuality(0);
+
+    QImage image = reader.read();
+
+    if (image.isNull())
+        return QImage{};
+
+    if (image.size() != size) // a handler may ignore the scaled size
+        image = image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    return image;
+}
+
+std::optional<quint64> ImageHashCalculator::hash(QImage image, PerceptualHash::Algorithm algorithm)
+{
+    if (image.isNull())
+        return std::nullopt;
+
+    image.convertTo(QImage::Format_Grayscale8);
+
+    switch (algorithm) {
+    case PerceptualHash::Algorithm::Difference:
+        return differenceHash(image);
+    case PerceptualHash::Algorithm::Average:
+        return averageHash(image);
+    case PerceptualHash::Algorithm::Dct:
+        return dctHash(image);
+    case PerceptualHash::Algorithm::Wavelet:
+        return waveletHash(image);
+    }
+
+    return std::nullopt;
 }
@@ -19,17 +19,47 @@
 
 #pragma once
 
+#include "imagehashalgorithm.h"
+
+#include <QImage>
 #include <QString>
 
-// Perceptual Hash - dHash
+#include <memory>
+#include <optional>
+
+class QImageReader;
+
+// Perceptual Hash - dHash, aHash, pHash and wHash
 
 class ImageHashCalculator
 {
 public:
     ImageHashCalculator(QStringView filePath);
+    ~ImageHashCalculator();
+
+    // nullopt if the file is not a readable image.
+    std::optional<quint64> result(PerceptualHash::Algorithm algorithm);
 
-    QString resultString();
+    // the hash of the Exif thumbnail, without reading the image data.
+    // nullopt if the file has no JPEG thumbnail. the thumbnail is read once per file.
+    std::optional<quint64> thumbnailResult(PerceptualHash::Algorithm algorithm);
+
+    // bytes result() allocates for the decoded image, from the header only.
+    // 0 if no image plugin can read the file. result() reuses the reader of the estimate.
+    qint64 decodeMemoryEstimate(PerceptualHash::Algorithm algorithm);
+
+    // for images whose header does not tell the size.
+    static constexpr qint64 unknownSizeMemoryEstimate = 64 * 1024 * 1024;
 
 private:
+    // decodes the image directly at the size. a null image if it can not be read.
+    static QImage scaledImage(QImageReader &reader, QSize size);
+    static std::optional<quint64> hash(QImage image, PerceptualHash::Algorithm algorithm);
+
+    // the format is probed once per reader. a reader reads the image only once
+    QImageReader &reader();
+
     const QString m_filePath;
+    std::optional<QByteArray> m_exifThumbnail;
+    std::unique_ptr<QImageReader> m_reader;
 };
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "imagehashservice.h"
+#include "imagehashcalculator.h"
+#include "imageheader.h"
+#include "multiindexhash.h"
+
+#include "application.h"
+#include "path/inodegroups.h"
+#include "path/pathentity.h"
+
+#include <QDebug>
+#include <QSettings>
+#include <QThread>
+
+namespace {
+
+namespace Settings {
+constexpr char groupName[] = "ImageHash";
+constexpr char keyDecodeMemoryBudgetMiB[] = "DecodeMemoryBudgetMiB";
+constexpr char keyUseExifThumbnail[] = "UseExifThumbnail";
+constexpr char keyExifThumbnailCheckInterval[] = "ExifThumbnailCheckInterval";
+} // Settings
+
+constexpr int defaultMemoryBudgetMiB = 256;
+constexpr int defaultThumbnailCheckInterval = 50;
+
+} // anonymous
+
+ImageHashService::ImageHashService(const EntityList &entities,
+                                   const Path::InodeGroups *inodeGroups,
+                                   QList<PerceptualHash::Algorithm> algorithms,
+                                   bool isImageHeaderNeeded, qint64 memoryBudget,
+                                   bool useExifThumbnail,
+                                   int thumbnailCheckInterval)
+    : m_entities(entities),
+      m_algorithms(algorithms),
+      m_isImageHeaderNeeded(isImageHeaderNeeded),
+      m_memoryBudget(qMax<qint64>(1, memoryBudget)),
+      m_useExifThumbnail(useExifThumbnail),
+      m_thumbnailCheckInterval(qMax(0, thumbnailCheckInterval)),
+      m_isDone(entities.size(), false),
+      m_availableMemory(m_memoryBudget)
+{
+    for (qsizetype i = 0, count = m_entities.size(); i < count; ++i) {
+        const bool isFollower = inodeGroups != nullptr && !inodeGroups->isLeader(i);
+
+        const bool isNothingToDo = m_algorithms.isEmpty() && !m_isImageHeaderNeeded;
+
+        if (m_entities.at(i)->isDir() || isNothingToDo || isFollower)
+            m_isDone[i] = true;
+        else
+            m_indices.append(i);
+    }
+
+    m_threadPool.setMaxThreadCount(QThread::idealThreadCount());
+}
+
+ImageHashService::~ImageHashService()
+{
+    cancel();
+    m_threadPool.waitForDone();
+
+    logThumbnailCheck();
+}
+
+void ImageHashService::start()
+{
+    const int workerCount = qMin(m_threadPool.maxThreadCount(), int(m_indices.size()));
+
+    for (int i = 0; i < workerCount; ++i)
+        m_threadPool.start([this]() { hashEntities(); });
+}
+
+void ImageHashService::cancel()
+{
+    m_isCanceled = true;
+
+    QMutexLocker locker(&m_mutex);
+
+    m_doneCondition.wakeAll();
+    m_memoryCondition.wakeAll();
+}
+
+void ImageHashService::waitForEntity(qsizetype index)
+{
+    QMutexLocker locker(&m_mutex);
+
+    while (!m_isDone.at(index) && !m_isCanceled)
+        m_doneCondition.wait(&m_mutex);
+}
+
+qint64 ImageHashService::memoryBudget()
+{
+    QSharedPointer<QSettings> qSet = Application::mainQSettings();
+
+    qSet->beginGroup(Settings::groupName);
+
+    const int budgetMiB = qSet->value(Settings::keyDecodeMemoryBudgetMiB,
+                                      defaultMemoryBudgetMiB).toInt();
+
+    qSet->endGroup();
+
+    return qint64(qMax(1, budgetMiB)) * 1024 * 1024;
+}
+
+bool ImageHashService::isExifThumbnailEnabled()
+{
+    QSharedPointer<QSettings> qSet = Application::mainQSettings();
+
+    qSet->beginGroup(Settings::groupName);
+
+    const bool isEnabled = qSet->value(Settings::keyUseExifThumbnail, false).toBool();
+
+    qSet->endGroup();
+
+    return isEnabled;
+}
+
+int ImageHashService::exifThumbnailCheckInterval()
+{
+    QSharedPointer<QSettings> qSet = Application::mainQSettings();
+
+    qSet->beginGroup(Settings::groupName);
+
+    const int interval = qSet->value(Settings::keyExifThumbnailCheckInterval,
+                                     defaultThumbnailCheckInterval).toInt();
+
+    qSet->endGroup();
+
+    return interval;
+}
+
+void ImageHashService::hashEntities()
+{
+    while (!m_isCanceled) {
+        const qsizetype next = m_next++;
+
+        if (next >= m_indices.size())
+            return;
+
+        const qsizetype index = m_indices.at(next);
+        const SharedEntity &entity = m_entities.at(index);
+        const QString filePath = entity->fullPath();
+        ImageHashCalculator imageHash(filePath);
+
+        // a few bytes of the file, no memory budget needed
+        if (m_isImageHeaderNeeded)
+            entity->setImageHeader(ImageHeader::read(filePath));
+
+        for (PerceptualHash::Algorithm algorithm : m_algorithms) {
+            if (entity->imageHash(algorithm).has_value())
+                continue;
+
+            std::optional<quint64> hash;
+
+            if (m_useExifThumbnail)
+                hash = thumbnailHash(imageHash, algorithm);
+
+            if (!hash.has_value()) {
+                const qint64 estimate = imageHash.decodeMemoryEstimate(algorithm);
+
+                if (estimate == 0)
+                    break; // not an image
+
+                const qint64 memory = qMin(estimate, m_memoryBudget);
+
+                if (!acquireMemory(memory))
+                    return;
+
+                hash = imageHash.result(algorithm);
+
+                releaseMemory(memory);
+            }
+
+            if (!hash.has_value())
+                break; // not an image
+
+            entity->setImageHash(algorithm, *hash);
+        }
+
+        setDone(index);
+    }
+}
+
+// the thumbnail is at most 64 KiB and decodes outside the memory budget.
+std::optional<quint64> ImageHashService::thumbnailHash(ImageHashCalculator &imageHash,
+                                                       PerceptualHash::Algorithm algorithm)
+{
+    const std::optional<quint64> hash = imageHash.thumbnailResult(algorithm);
+
+    if (!hash.has_value())
+        return std::nullopt;
+
+    const qsizetype count = m_thumbnailHashCount++;
+
+    if (m_thumbnailCheckInterval == 0 || count % m_thumbnailCheckInterval != 0)
+        return hash;
+
+    const qint64 estimate = imageHash.decodeMemoryEstimate(algorithm);
+
+    if (estimate == 0)
+        return hash;
+
+    const qint64 memory = qMin(estimate, m_memoryBudget);
+
+    if (!acquireMemory(memory))
+        return hash;
+
+    const std::optional<quint64> fullHash = imageHash.result(algorithm);
+
+    releaseMemory(memory);
+
+    if (!fullHash.has_value())
+        return hash;
+
+    const int distance = MultiIndexHash::distance(*hash, *fullHash);
+
+    QMutexLocker locker(&m_mutex);
+
+    ++m_thumbnailCheck.comparedCount;
+    m_thumbnailCheck.distanceSum += distance;
+
+    if (distance == 0)
+        ++m_thumbnailCheck.identicalCount;
+
+    if (distance <= nearDistance)
+        ++m_thumbnailCheck.nearCount;
+
+    return hash;
+}
+
+void ImageHashService::logThumbnailCheck() const
+{
+    if (m_thumbnailHashCount == 0)
+        return;
+
+    const ThumbnailCheck &check = m_thumbnailCheck;
+
+    qInfo().noquote() << QStringLiteral("%1 image hash(es) from Exif thumbnails.")
+                         .arg(m_thumbnailHashCount.load());
+
+    if (check.comparedCount == 0)
+        return;
+
+    qInfo().noquote() << QStringLiteral("Exif thumbnail against full image: %1 compared, "
+                                        "%2 identical, %3 within %4 bits, mean distance %5 bits.")
+                         .arg(check.comparedCount).arg(check.identicalCount)
+                         .arg(check.nearCount).arg(nearDistance)
+                         .arg(double(check.distanceSum) / check.comparedCount, 0, 'f', 2);
+}
+
+bool ImageHashService::acquireMemory(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+
+    while (m_availableMemory < bytes && !m_isCanceled)
+        m_memoryCondition.wait(&m_mutex);
+
+    if (m_isCanceled)
+        return false;
+
+    m_availableMemory -= bytes;
+
+    return true;
+}
+
+void ImageHashService::releaseMemory(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_availableMemory += bytes;
+    m_memoryCondition.wakeAll();
+}
+
+void ImageHashService::setDone(qsizetype index)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_isDone[index] = true;
+    m_doneCondition.wakeAll();
+}
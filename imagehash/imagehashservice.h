@@ -0,0 +1,104 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "imagehashalgorithm.h"
+#include "path/usingpathentity.h"
+
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <optional>
+
+namespace Path {
+class InodeGroups;
+}
+
+class ImageHashCalculator;
+
+// Computes image hashes and reads image headers on every core ahead of the name generator.
+// A decode starts only while its estimated memory fits in the budget shared by all
+// workers, so a folder of huge images runs fewer decodes at a time instead of
+// running out of memory. An image larger than the whole budget is decoded alone.
+// Optionally hashes the Exif thumbnail of a JPEG instead of decoding the image, and
+// every Nth such image also from the full image to report how often the two disagree.
+class ImageHashService
+{
+    Q_DISABLE_COPY_MOVE(ImageHashService)
+public:
+    // only the first entity of each inode in inodeGroups is hashed. the caller shares
+    // its results with the others. inodeGroups is used only in the constructor.
+    ImageHashService(const EntityList &entities, const Path::InodeGroups *inodeGroups,
+                     QList<PerceptualHash::Algorithm> algorithms, bool isImageHeaderNeeded,
+                     qint64 memoryBudget, bool useExifThumbnail, int thumbnailCheckInterval);
+    ~ImageHashService();
+
+    void start();
+    void cancel();
+
+    // blocks until the hashes and the header of entities[index] are set to the entity,
+    // failed or canceled.
+    void waitForEntity(qsizetype index);
+
+    static qint64 memoryBudget(); // bytes
+    static bool isExifThumbnailEnabled();
+    static int exifThumbnailCheckInterval(); // 0 disables the check
+
+private:
+    struct ThumbnailCheck
+    {
+        qsizetype comparedCount = 0;
+        qsizetype identicalCount = 0;
+        qsizetype nearCount = 0; // within nearDistance, identical ones included
+        qint64 distanceSum = 0;
+    };
+
+    static constexpr int nearDistance = 10;
+
+    void hashEntities();
+    std::optional<quint64> thumbnailHash(ImageHashCalculator &imageHash,
+                                         PerceptualHash::Algorithm algorithm);
+    void logThumbnailCheck() const;
+    bool acquireMemory(qint64 bytes);
+    void releaseMemory(qint64 bytes);
+    void setDone(qsizetype index);
+
+    const EntityList m_entities;
+    const QList<PerceptualHash::Algorithm> m_algorithms;
+    const bool m_isImageHeaderNeeded;
+    const qint64 m_memoryBudget;
+    const bool m_useExifThumbnail;
+    const int m_thumbnailCheckInterval;
+
+    QList<qsizetype> m_indices;
+    std::atomic<qsizetype> m_next = 0;
+    std::atomic_bool m_isCanceled = false;
+    std::atomic<qsizetype> m_thumbnailHashCount = 0;
+
+    QMutex m_mutex;
+    QWaitCondition m_doneCondition;
+    QWaitCondition m_memoryCondition;
+    QList<bool> m_isDone;
+    qint64 m_availableMemory;
+    ThumbnailCheck m_thumbnailCheck;
+
+    QThreadPool m_threadPool;
+};
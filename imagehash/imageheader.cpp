@@ -0,0 +1,145 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "imageheader.h"
+#include "jpegsegmentreader.h"
+
+#include <QFile>
+#include <QImageReader>
+#include <QtEndian>
+
+namespace {
+
+// enough for the fixed headers of PNG, GIF and WebP
+constexpr qint64 headerPeekSize = 32;
+
+quint16 littleEndian16(const QByteArray &bytes, qsizetype offset)
+{
+    return qFromLittleEndian<quint16>(bytes.data() + offset);
+}
+
+quint32 littleEndian24(const QByteArray &bytes, qsizetype offset)
+{
+    return quint32(uchar(bytes[offset])) | quint32(uchar(bytes[offset + 1])) << 8
+           | quint32(uchar(bytes[offset + 2])) << 16;
+}
+
+// signature, then the IHDR chunk, which must come first
+QSize pngSize(const QByteArray &bytes)
+{
+    if (bytes.size() < 24 || !bytes.startsWith("\x89PNG\r\n\x1a\n")
+        || bytes.sliced(12, 4) != "IHDR") {
+        return QSize{};
+    }
+
+    return QSize(qFromBigEndian<qint32>(bytes.data() + 16), qFromBigEndian<qint32>(bytes.data() + 20));
+}
+
+// the logical screen size
+QSize gifSize(const QByteArray &bytes)
+{
+    if (bytes.size() < 10 || !(bytes.startsWith("GIF87a") || bytes.startsWith("GIF89a")))
+        return QSize{};
+
+    return QSize(littleEndian16(bytes, 6), littleEndian16(bytes, 8));
+}
+
+// the first chunk is VP8 (lossy), VP8L (lossless) or VP8X (extended)
+QSize webpSize(const QByteArray &bytes)
+{
+    if (bytes.size() < 30 || !bytes.startsWith("RIFF") || bytes.sliced(8, 4) != "WEBP")
+        return QSize{};
+
+    const QByteArray chunk = bytes.sliced(12, 4);
+
+    if (chunk == "VP8 ") {
+        // 3 bytes of frame tag and the start code 9d 01 2a before the 14-bit sizes
+        if (bytes.sliced(23, 3) != "\x9d\x01\x2a")
+            return QSize{};
+
+        return QSize(littleEndian16(bytes, 26) & 0x3fff, littleEndian16(bytes, 28) & 0x3fff);
+    }
+
+    if (chunk == "VP8L") {
+        // a signature byte, then width - 1 and height - 1 in 14 bits each
+        if (uchar(bytes[20]) != 0x2f)
+            return QSize{};
+
+        const quint32 bits = qFromLittleEndian<quint32>(bytes.data() + 21);
+
+        return QSize(int(bits & 0x3fff) + 1, int((bits >> 14) & 0x3fff) + 1);
+    }
+
+    if (chunk == "VP8X") // 4 bytes of flags, then width - 1 and height - 1 in 24 bits each
+        return QSize(int(littleEndian24(bytes, 24)) + 1, int(littleEndian24(bytes, 27)) + 1);
+
+    return QSize{};
+}
+
+// the frame header: precision, height and width
+QSize jpegSize(QIODevice *device)
+{
+    JpegSegmentReader reader(device);
+
+    if (!reader.start())
+        return QSize{};
+
+    while (reader.next()) {
+        if (!JpegSegmentReader::isStartOfFrame(reader.marker()))
+            continue;
+
+        const QByteArray frame = reader.read(5);
+
+        if (frame.size() != 5)
+            return QSize{};
+
+        return QSize(qFromBigEndian<quint16>(frame.constData() + 3),
+                     qFromBigEndian<quint16>(frame.constData() + 1));
+    }
+
+    return QSize{};
+}
+
+} // anonymous
+
+ImageHeader ImageHeader::read(const QString &filePath)
+{
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return ImageHeader{};
+
+    const QByteArray bytes = file.peek(headerPeekSize);
+
+    if (bytes.startsWith("\xff\xd8"))
+        return ImageHeader{jpegSize(&file), QByteArrayLiteral("jpeg")};
+
+    if (QSize size = pngSize(bytes); size.isValid())
+        return ImageHeader{size, QByteArrayLiteral("png")};
+
+    if (QSize size = gifSize(bytes); size.isValid())
+        return ImageHeader{size, QByteArrayLiteral("gif")};
+
+    if (QSize size = webpSize(bytes); size.isValid())
+        return ImageHeader{size, QByteArrayLiteral("webp")};
+
+    // the handlers of the other formats read the size from the header as well
+    QImageReader reader(&file);
+
+    return ImageHeader{reader.size(), reader.format()};
+}
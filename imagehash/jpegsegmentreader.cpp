@@ -0,0 +1,120 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "jpegsegmentreader.h"
+
+#include <QIODevice>
+#include <QtEndian>
+
+namespace {
+
+namespace Marker {
+constexpr uchar prefix = 0xff;
+constexpr uchar tem = 0x01;
+constexpr uchar sof0 = 0xc0;
+constexpr uchar dht = 0xc4;
+constexpr uchar jpg = 0xc8;
+constexpr uchar dac = 0xcc;
+constexpr uchar sof15 = 0xcf;
+constexpr uchar rst0 = 0xd0;
+constexpr uchar rst7 = 0xd7;
+constexpr uchar soi = 0xd8;
+constexpr uchar eoi = 0xd9;
+constexpr uchar sos = 0xda;
+} // Marker
+
+} // anonymous
+
+JpegSegmentReader::JpegSegmentReader(QIODevice *device)
+    : m_device(device)
+{
+    Q_ASSERT(device != nullptr);
+}
+
+bool JpegSegmentReader::start()
+{
+    const QByteArray soi = m_device->read(2);
+
+    return soi.size() == 2 && uchar(soi[0]) == Marker::prefix && uchar(soi[1]) == Marker::soi;
+}
+
+bool JpegSegmentReader::next()
+{
+    if (m_remaining > 0 && m_device->skip(m_remaining) != m_remaining)
+        return false;
+
+    m_remaining = 0;
+
+    char prefix = 0;
+
+    if (!m_device->getChar(&prefix) || uchar(prefix) != Marker::prefix)
+        return false;
+
+    do { // a marker may be preceded by fill bytes
+        char byte = 0;
+
+        if (!m_device->getChar(&byte))
+            return false;
+
+        m_marker = uchar(byte);
+    } while (m_marker == Marker::prefix);
+
+    if (m_marker == Marker::sos || m_marker == Marker::eoi)
+        return false;
+
+    // markers without a payload
+    if (m_marker == Marker::tem || (m_marker >= Marker::rst0 && m_marker <= Marker::rst7)) {
+        m_length = 0;
+        return true;
+    }
+
+    const QByteArray lengthBytes = m_device->read(2);
+
+    if (lengthBytes.size() != 2)
+        return false;
+
+    m_length = qFromBigEndian<quint16>(lengthBytes.constData()) - 2;
+    m_remaining = m_length;
+
+    return m_length >= 0;
+}
+
+uchar JpegSegmentReader::marker() const
+{
+    return m_marker;
+}
+
+qint64 JpegSegmentReader::length() const
+{
+    return m_length;
+}
+
+QByteArray JpegSegmentReader::read(qint64 maxSize)
+{
+    const QByteArray data = m_device->read(qMin(maxSize, m_remaining));
+
+    m_remaining -= data.size();
+
+    return data;
+}
+
+bool JpegSegmentReader::isStartOfFrame(uchar marker)
+{
+    return marker >= Marker::sof0 && marker <= Marker::sof15
+           && marker != Marker::dht && marker != Marker::jpg && marker != Marker::dac;
+}
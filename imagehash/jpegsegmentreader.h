@@ -0,0 +1,52 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QByteArray>
+
+class QIODevice;
+
+// Walks the marker segments of a JPEG up to the image data. Only the segments
+// the caller reads are loaded; the rest are skipped.
+class JpegSegmentReader
+{
+public:
+    static constexpr uchar app1Marker = 0xe1;
+
+    explicit JpegSegmentReader(QIODevice *device);
+
+    // false if the device does not start with SOI.
+    bool start();
+    // moves to the next segment. false at SOS, EOI, the end of the device or a broken marker.
+    bool next();
+
+    uchar marker() const;
+    qint64 length() const; // bytes of the payload, without the length field
+    // reads up to maxSize bytes of the current payload.
+    QByteArray read(qint64 maxSize);
+
+    // SOF0 to SOF15 except DHT, JPG and DAC, which share the range.
+    static bool isStartOfFrame(uchar marker);
+
+private:
+    QIODevice *m_device;
+    uchar m_marker = 0;
+    qint64 m_length = 0;
+    qint64 m_remaining = 0;
+};
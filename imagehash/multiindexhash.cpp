@@ -0,0 +1,170 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "multiindexhash.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+
+qsizetype combinationCount(int n, int k)
+{
+    qsizetype count = 1;
+
+    for (int i = 0; i < k; ++i)
+        count = count * (n - i) / (i + 1);
+
+    return count;
+}
+
+int partWidth(int part, int partCount)
+{
+    return 64 / partCount + (part < 64 % partCount ? 1 : 0);
+}
+
+// the part values looked up by a query, and the values expected in their buckets when
+// the values are spread evenly. more and narrower parts take fewer lookups, but their
+// buckets hold more values.
+double queryCost(int radius, int partCount, qsizetype expectedSize)
+{
+    double cost = 0;
+
+    for (int i = 0; i < partCount; ++i) {
+        const int width = partWidth(i, partCount);
+        qsizetype lookupCount = 0;
+
+        for (int k = 0; k <= qMin(radius / partCount, width); ++k)
+            lookupCount += combinationCount(width, k);
+
+        cost += double(lookupCount) * (1 + double(expectedSize) / std::exp2(width));
+    }
+
+    return cost;
+}
+
+// calls probe with every value of width bits within radius from value.
+template <typename Probe>
+void forEachNear(quint64 value, int width, int radius, int firstBit, const Probe &probe)
+{
+    probe(value);
+
+    if (radius == 0)
+        return;
+
+    for (int bit = firstBit; bit < width; ++bit)
+        forEachNear(value ^ (quint64(1) << bit), width, radius - 1, bit + 1, probe);
+}
+
+} // anonymous
+
+MultiIndexHash::MultiIndexHash(int radius, qsizetype expectedSize)
+    : m_radius(qBound(0, radius, 64))
+{
+    // more than radius + 1 parts only narrow the buckets
+    int partCount = 1;
+    m_queryCost = queryCost(m_radius, 1, expectedSize);
+
+    for (int count = 2; count <= qMin(m_radius + 1, 64); ++count) {
+        const double cost = queryCost(m_radius, count, expectedSize);
+
+        if (cost < m_queryCost) {
+            partCount = count;
+            m_queryCost = cost;
+        }
+    }
+
+    m_partRadius = m_radius / partCount;
+
+    for (int i = 0, shift = 0; i < partCount; ++i) {
+        const int width = partWidth(i, partCount);
+
+        m_parts.push_back(Part{shift, width, {}});
+        shift += width;
+    }
+}
+
+qsizetype MultiIndexHash::insert(quint64 value)
+{
+    const auto itr = m_indexOfValue.constFind(value);
+
+    if (itr != m_indexOfValue.constEnd())
+        return itr.value();
+
+    const qsizetype index = qsizetype(m_values.size());
+
+    m_values.push_back(value);
+    m_indexOfValue.insert(value, index);
+
+    for (Part &part : m_parts)
+        part.table[partValue(part, value)].append(index);
+
+    return index;
+}
+
+void MultiIndexHash::query(quint64 value, const std::function<void(qsizetype)> &found) const
+{
+    if (m_queryCost >= double(size())) {
+        for (qsizetype i = 0, count = size(); i < count; ++i) {
+            if (distance(m_values[size_t(i)], value) <= m_radius)
+                found(i);
+        }
+
+        return;
+    }
+
+    std::vector<qsizetype> candidates;
+
+    for (const Part &part : m_parts) {
+        forEachNear(partValue(part, value), part.width, m_partRadius, 0,
+                    [&part, &candidates](quint64 near) {
+            const auto itr = part.table.constFind(near);
+
+            if (itr != part.table.constEnd())
+                candidates.insert(candidates.end(), itr->cbegin(), itr->cend());
+        });
+    }
+
+    // a value near in several parts is a candidate of each
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    for (qsizetype candidate : candidates) {
+        if (distance(m_values[size_t(candidate)], value) <= m_radius)
+            found(candidate);
+    }
+}
+
+qsizetype MultiIndexHash::size() const
+{
+    return qsizetype(m_values.size());
+}
+
+int MultiIndexHash::distance(quint64 lhs, quint64 rhs)
+{
+    return std::popcount(lhs ^ rhs);
+}
+
+quint64 MultiIndexHash::partValue(const Part &part, quint64 value) const
+{
+    const quint64 mask = (part.width >= 64) ? ~quint64(0) : (quint64(1) << part.width) - 1;
+
+    return (value >> part.shift) & mask;
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+
+#include <functional>
+#include <vector>
+
+// Multi-index hashing of 64-bit hashes in the Hamming distance. Each value is cut into
+// parts, each part indexed in its own table. Two values within radius differ in at most
+// radius / partCount bits of some part by the pigeonhole principle, so a query looks up
+// only the part values within that distance. The part count is the one with the fewest
+// lookups and expected candidates for the expected size. When those would outnumber the
+// values, a query compares all values instead.
+// Queries are thread safe while nothing is inserted.
+class MultiIndexHash
+{
+public:
+    MultiIndexHash(int radius, qsizetype expectedSize);
+
+    // returns the index of the value, in the order of insertion.
+    // a value already in the table is not inserted again.
+    qsizetype insert(quint64 value);
+
+    // calls found with the index of every value within radius from value.
+    void query(quint64 value, const std::function<void(qsizetype)> &found) const;
+
+    qsizetype size() const;
+
+    static int distance(quint64 lhs, quint64 rhs);
+
+private:
+    struct Part {
+        int shift;
+        int width;
+        QHash<quint64, QList<qsizetype>> table;
+    };
+
+    quint64 partValue(const Part &part, quint64 value) const;
+
+    const int m_radius;
+    int m_partRadius = 0;
+    double m_queryCost = 0; // lookups and candidates per query
+
+    std::vector<Part> m_parts;
+    std::vector<quint64> m_values;
+    QHash<quint64, qsizetype> m_indexOfValue;
+};
@@ -58,6 +58,7 @@ void loadMainGeometry(MainWindow *window, Ui::MainWindow *ui)
         window->restoreState(stateArray);
     } else {
         ui->dockWidgetLogs->setVisible(false);
+        ui->dockWidgetHashStatistics->setVisible(false);
         ui->splitter->setSizes({400, 300});
     }
 
@@ -88,6 +89,9 @@ MainWindow::MainWindow(QWidget *parent)
     hSpacer->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
     ui->toolBar->insertWidget(ui->actionClearItems, hSpacer);
 
+    tabifyDockWidget(ui->dockWidgetLogs, ui->dockWidgetHashStatistics);
+    ui->toolBar->addAction(ui->dockWidgetHashStatistics->toggleViewAction());
+
     loadMainGeometry(this, ui);
     initStatusBar();
 
@@ -270,12 +274,14 @@ void MainWindow::registerPaths(const QStringList &paths)
     });
 
     PathsAnalyzer analyzer;
+    const bool isCollapseSameInode = DialogDroppedDir::isCollapseSameInode();
 
+    analyzer.setCollapseSameInode(isCollapseSameInode);
     analyzer.analyze(paths);
 
     if (!analyzer.isAllDir()) {
         qInfo() << tr("Register dropped paths.");
-        m_pathModel->addPaths(analyzer.dirs(), analyzer.files());
+        m_pathModel->addPaths(analyzer.dirs(), analyzer.files(), isCollapseSameInode);
 
         return;
     }
@@ -297,7 +303,7 @@ void MainWindow::registerPaths(const QStringList &paths)
     if (dlg.exec() == QDialog::Rejected)
         return;
 
-    m_pathModel->addPaths(dlg.dirsToRename(), dlg.filesToRename());
+    m_pathModel->addPaths(dlg.dirsToRename(), dlg.filesToRename(), isCollapseSameInode);
 }
 
 int MainWindow::execConfirmRenameDirDlg(const QStringList &dirPaths)
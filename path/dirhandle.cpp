@@ -0,0 +1,102 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "dirhandle.h"
+
+#include <cerrno>
+
+#ifdef Q_OS_LINUX
+#include <QFile>
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#ifdef RENAME_NOREPLACE // glibc 2.28
+#define PATH_HAS_RENAMEAT2
+#endif
+#endif
+
+namespace Path {
+
+DirHandle::~DirHandle()
+{
+    close();
+}
+
+int DirHandle::rename(const QString &dirPath, const QString &name, const QString &newName)
+{
+#ifdef PATH_HAS_RENAMEAT2
+    int fd = -1;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (m_isUnsupported)
+            return ENOSYS;
+
+        if (m_fd == -1) {
+            m_fd = ::open(QFile::encodeName(dirPath).constData(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+
+            if (m_fd == -1)
+                return (errno == EMFILE || errno == ENFILE) ? ENOSYS : errno;
+        }
+
+        fd = m_fd;
+    }
+
+    if (::renameat2(fd, QFile::encodeName(name).constData(),
+                    fd, QFile::encodeName(newName).constData(), RENAME_NOREPLACE) == 0) {
+        return 0;
+    }
+
+    const int error = errno;
+
+    // a kernel before 3.15 or a file system without RENAME_NOREPLACE
+    if (error == ENOSYS || error == EINVAL) {
+        QMutexLocker locker(&m_mutex);
+
+        m_isUnsupported = true;
+
+        return ENOSYS;
+    }
+
+    return error;
+#else
+    Q_UNUSED(dirPath)
+    Q_UNUSED(name)
+    Q_UNUSED(newName)
+
+    return ENOSYS;
+#endif
+}
+
+void DirHandle::close()
+{
+#ifdef PATH_HAS_RENAMEAT2
+    QMutexLocker locker(&m_mutex);
+
+    if (m_fd != -1)
+        ::close(m_fd);
+
+    m_fd = -1;
+    m_isUnsupported = false;
+#endif
+}
+
+} // Path
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QMutex>
+#include <QString>
+
+namespace Path {
+
+// A directory opened once with O_PATH, whose entries are renamed with renameat2() and
+// RENAME_NOREPLACE: the path is not resolved again for every entry, an existing entry is
+// never replaced and a failure tells its cause in errno. Linux only.
+class DirHandle
+{
+    Q_DISABLE_COPY_MOVE(DirHandle)
+public:
+    DirHandle() = default;
+    ~DirHandle();
+
+    // 0 on success, otherwise the errno of the rename or of opening dirPath.
+    // ENOSYS where renameat2() can not be used, neither on the platform, nor on the file
+    // system, nor with the descriptors left; the caller then renames by path.
+    int rename(const QString &dirPath, const QString &name, const QString &newName);
+    void close();
+
+private:
+    QMutex m_mutex;
+    int m_fd = -1;
+    bool m_isUnsupported = false;
+};
+
+} // Path
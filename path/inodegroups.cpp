@@ -0,0 +1,87 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inodegroups.h"
+#include "pathentity.h"
+
+#include <QFile>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+namespace Path {
+
+std::optional<InodeKey> inodeKeyOf(const QString &path, bool isFollowSymlink)
+{
+#ifdef Q_OS_UNIX
+    struct stat status;
+
+    const QByteArray encodedPath = QFile::encodeName(path);
+    const int result = isFollowSymlink ? ::stat(encodedPath.constData(), &status)
+                                       : ::lstat(encodedPath.constData(), &status);
+    if (result != 0)
+        return std::nullopt;
+
+    return InodeKey{quint64(status.st_dev), quint64(status.st_ino)};
+#else
+    Q_UNUSED(path)
+    Q_UNUSED(isFollowSymlink)
+
+    return std::nullopt;
+#endif
+}
+
+InodeGroups::InodeGroups(const EntityList &entities)
+{
+    QHash<InodeKey, qsizetype> inodeToLeader;
+
+    m_leaders.reserve(entities.size());
+
+    for (qsizetype i = 0, count = entities.size(); i < count; ++i) {
+        m_leaders.append(i);
+
+        if (entities.at(i)->isDir())
+            continue;
+
+        const std::optional<InodeKey> key = inodeKeyOf(entities.at(i)->fullPath());
+
+        if (!key.has_value())
+            continue;
+
+        const auto itr = inodeToLeader.constFind(*key);
+
+        if (itr == inodeToLeader.cend())
+            inodeToLeader.insert(*key, i);
+        else
+            m_leaders[i] = itr.value();
+    }
+}
+
+qsizetype InodeGroups::leaderOf(qsizetype index) const
+{
+    return m_leaders.at(index);
+}
+
+bool InodeGroups::isLeader(qsizetype index) const
+{
+    return m_leaders.at(index) == index;
+}
+
+} // Path
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "usingpathentity.h"
+
+#include <QHash>
+#include <QString>
+
+#include <optional>
+
+namespace Path {
+
+struct InodeKey {
+    quint64 device;
+    quint64 inode;
+
+    bool operator==(const InodeKey &other) const = default;
+};
+
+inline size_t qHash(const InodeKey &key, size_t seed = 0) noexcept
+{
+    return qHashMulti(seed, key.device, key.inode);
+}
+
+// nullopt if the platform has no inode numbers or the path can not be stat'ed.
+// isFollowSymlink = false identifies a symbolic link itself, not its target.
+std::optional<InodeKey> inodeKeyOf(const QString &path, bool isFollowSymlink = true);
+
+// Finds entities that are the same file, through hard links or duplicate registrations,
+// so that results derived from the content are computed once per inode.
+class InodeGroups
+{
+public:
+    explicit InodeGroups(const EntityList &entities);
+
+    // the first entity of the same file. index itself if it is the first or unknown.
+    qsizetype leaderOf(qsizetype index) const;
+
+    bool isLeader(qsizetype index) const;
+
+private:
+    QList<qsizetype> m_leaders;
+};
+
+} // Path
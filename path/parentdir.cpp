@@ -87,6 +87,16 @@ QString ParentDir::path() const
     return m_path;
 }
 
+int ParentDir::renameEntry(const QString &name, const QString &newName)
+{
+    return m_dirHandle.rename(m_path, name, newName);
+}
+
+void ParentDir::releaseDirHandle()
+{
+    m_dirHandle.close();
+}
+
 void ParentDir::sort(QCollator &collator, Qt::SortOrder order)
 {
     QWriteLocker locker(rwLock);
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "dirhandle.h"
 #include "usingpathentity.h"
 
 namespace Path {
@@ -40,9 +41,16 @@ public:
     QString path() const;
     void sort(QCollator &collator, Qt::SortOrder order);
 
+    // renames an entry of this directory without replacing an existing one.
+    // 0 on success, otherwise errno. ENOSYS if it has to be renamed by path.
+    int renameEntry(const QString &name, const QString &newName);
+    // closes the directory opened by renameEntry(), at the end of a batch of renames.
+    void releaseDirHandle();
+
 private:
     const QString m_path;
     EntityList m_children;
+    DirHandle m_dirHandle;
 };
 
 } // Path
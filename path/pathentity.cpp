@@ -25,6 +25,9 @@
 #include <QDir>
 #include <QFileIconProvider>
 #include <QReadWriteLock>
+#include <QUuid>
+
+#include <cerrno>
 
 namespace Path {
 
@@ -81,36 +84,130 @@ QWeakPointer<ParentDir> PathEntity::parent() const
     return m_parent;
 }
 
-QString PathEntity::hashHex(QCryptographicHash::Algorithm algorithm) const
+FileDigest PathEntity::fileDigest(FileHash::Algorithm algorithm) const
+{
+    for (const FileDigest &digest : m_fileDigests) {
+        if (digest.algorithm() == algorithm)
+            return digest;
+    }
+
+    return FileDigest{};
+}
+
+std::optional<quint64> PathEntity::imageHash(PerceptualHash::Algorithm algorithm) const
+{
+    for (const auto &[storedAlgorithm, hash] : m_imageHashes) {
+        if (storedAlgorithm == algorithm)
+            return hash;
+    }
+
+    return std::nullopt;
+}
+
+int PathEntity::duplicateGroup() const
+{
+    return m_duplicateGroup;
+}
+
+int PathEntity::imageGroup(PerceptualHash::Algorithm algorithm, int threshold) const
 {
-    return m_fileHashs[algorithm];
+    const ImageGroupEntry *entry = findImageGroup(algorithm, threshold);
+
+    return (entry != nullptr) ? entry->group : 0;
 }
 
-QString PathEntity::imageHash() const
+int PathEntity::imageGroupMember(PerceptualHash::Algorithm algorithm, int threshold) const
 {
-    return m_imageHash;
+    const ImageGroupEntry *entry = findImageGroup(algorithm, threshold);
+
+    return (entry != nullptr) ? entry->member : 0;
 }
 
-void PathEntity::setHashHex(QCryptographicHash::Algorithm algorithm, QStringView hashHex)
+std::optional<ImageHeader> PathEntity::imageHeader() const
 {
-    m_fileHashs[algorithm] = hashHex.toString();
+    return m_imageHeader;
+}
+
+void PathEntity::setFileDigest(const FileDigest &digest)
+{
+    for (FileDigest &stored : m_fileDigests) {
+        if (stored.algorithm() == digest.algorithm()) {
+            stored = digest;
+            return;
+        }
+    }
+
+    m_fileDigests.append(digest);
+}
+
+void PathEntity::setImageHash(PerceptualHash::Algorithm algorithm, quint64 imageHash)
+{
+    for (auto &[storedAlgorithm, hash] : m_imageHashes) {
+        if (storedAlgorithm == algorithm) {
+            hash = imageHash;
+            return;
+        }
+    }
+
+    m_imageHashes.append({algorithm, imageHash});
 }
 
-void PathEntity::setImageHash(QStringView imageHash)
+void PathEntity::setDuplicateGroup(int group)
 {
-    m_imageHash = imageHash.toString();
+    m_duplicateGroup = group;
+}
+
+void PathEntity::setImageGroup(PerceptualHash::Algorithm algorithm, int threshold,
+                               int group, int member)
+{
+    for (ImageGroupEntry &entry : m_imageGroups) {
+        if (entry.algorithm == algorithm && entry.threshold == threshold) {
+            entry.group = group;
+            entry.member = member;
+            return;
+        }
+    }
+
+    m_imageGroups.append({algorithm, threshold, group, member});
+}
+
+void PathEntity::setImageHeader(const ImageHeader &imageHeader)
+{
+    m_imageHeader = imageHeader;
 }
 
 void PathEntity::setNewName(QStringView newName)
 {
     QWriteLocker locker(rwLock);
 
-    m_newName = m_isDir ? newName.toString()
-                        : QStringLiteral("%1%2").arg(newName, m_name.mid(m_name.indexOf('.')));
+    if (m_isDir) {
+        m_newName = newName.toString();
+    } else {
+        const QStringView suffix = QStringView{m_name}.mid(m_name.indexOf('.'));
+
+        QString name;
+
+        name.reserve(newName.size() + suffix.size()); // the only allocation per new name.
+        name.append(newName).append(suffix);
+
+        m_newName = std::move(name);
+    }
 
     m_state = State::Initial;
 }
 
+void PathEntity::shareContentResults(const PathEntity &source)
+{
+    for (const FileDigest &digest : source.m_fileDigests)
+        setFileDigest(digest);
+
+    for (const auto &[algorithm, hash] : source.m_imageHashes)
+        setImageHash(algorithm, hash);
+
+    if (source.m_imageHeader.has_value())
+        m_imageHeader = source.m_imageHeader;
+}
+
 bool PathEntity::checkForNewNameCollisions(QSharedPointer<PathEntity> other)
 {
     if (isDir() && newName().isEmpty()) {
@@ -216,6 +313,16 @@ QString PathEntity::statusText() const
     return QString();
 }
 
+bool PathEntity::isReadyToRename() const
+{
+    return state() == State::Ready;
+}
+
+bool PathEntity::isRenamed() const
+{
+    return state() == State::Success;
+}
+
 bool PathEntity::rename()
 {
     if (state() == State::Success)
@@ -224,26 +331,38 @@ bool PathEntity::rename()
     if (state() != State::Ready)
         return false;
 
-    rwLock->lockForRead();
+    // copied under the lock. the rename and the log run without it
+    QSharedPointer<ParentDir> parent;
+    QString name;
+    QString newName;
+    QString source;
 
-    QDir dir(m_parent.lock()->path());
+    {
+        QReadLocker locker(rwLock);
 
-    bool isOk = dir.rename(m_name, m_newName);
+        parent = m_parent.lock();
+        name = m_name;
+        newName = m_newName;
+        source = m_temporaryName.isEmpty() ? m_name : m_temporaryName;
+    }
+
+    const ErrorCode errorCode = renameEntry(*parent, source, newName);
+    const bool isOk = (errorCode == ErrorCode::NoError);
 
     QString result = isOk ? QObject::tr("SUCCEEDED")
                           : QObject::tr("---FAILED");
 
-    QString log = QStringLiteral("%1|%2/%3 -> %4").arg(result, dir.absolutePath(), m_name, m_newName);
+    QString log = QStringLiteral("%1|%2%3 -> %4").arg(result, parent->path(), source, newName);
 
     ApplicationLog::instance().log(log, QStringLiteral("Rename"));
 
-    rwLock->unlock();
+    leaveTemporaryName(isOk ? QString() : name, u"Rename");
 
     if (isOk) {
         setState(State::Success);
     } else {
         setState(State::Failure);
-        findErrorCause();
+        setErrorCode(errorCode);
     }
 
     return isOk;
@@ -259,20 +378,30 @@ bool PathEntity::undoRename()
     if (state() != State::Success)
         return false;
 
-    rwLock->lockForRead();
+    QSharedPointer<ParentDir> parent;
+    QString name;
+    QString newName;
+    QString source;
+
+    {
+        QReadLocker locker(rwLock);
 
-    QDir dir(m_parent.lock()->path());
+        parent = m_parent.lock();
+        name = m_name;
+        newName = m_newName;
+        source = m_temporaryName.isEmpty() ? m_newName : m_temporaryName;
+    }
 
-    bool isOk = dir.rename(m_newName, m_name);
+    const bool isOk = (renameEntry(*parent, source, name) == ErrorCode::NoError);
 
     QString result = isOk ? QObject::tr("SUCCEEDED")
                           : QObject::tr("---FAILED");
 
-    QString log = QStringLiteral("%1|%2/%3 -> %4").arg(result, dir.absolutePath(), m_newName, m_name);
+    QString log = QStringLiteral("%1|%2%3 -> %4").arg(result, parent->path(), source, name);
 
     ApplicationLog::instance().log(log, QStringLiteral("Undo"));
 
-    rwLock->unlock();
+    leaveTemporaryName(isOk ? QString() : newName, u"Undo");
 
     isOk ? setState(State::Ready)
          : setState(State::Success);
@@ -280,6 +409,48 @@ bool PathEntity::undoRename()
     return isOk;
 }
 
+bool PathEntity::moveAside()
+{
+    const State currentState = state();
+
+    if (currentState != State::Ready && currentState != State::Success)
+        return false;
+
+    const bool isUndo = (currentState == State::Success);
+    const QString temporaryName = QStringLiteral(".%1.renaming")
+                                  .arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
+
+    QSharedPointer<ParentDir> parent;
+    QString source;
+
+    {
+        QReadLocker locker(rwLock);
+
+        parent = m_parent.lock();
+        source = isUndo ? m_newName : m_name;
+    }
+
+    const ErrorCode errorCode = renameEntry(*parent, source, temporaryName);
+    const bool isOk = (errorCode == ErrorCode::NoError);
+
+    QString result = isOk ? QObject::tr("SUCCEEDED")
+                          : QObject::tr("---FAILED");
+
+    QString log = QStringLiteral("%1|%2%3 -> %4").arg(result, parent->path(), source, temporaryName);
+
+    ApplicationLog::instance().log(log, isUndo ? QStringLiteral("Undo")
+                                               : QStringLiteral("Rename"));
+
+    if (isOk) {
+        m_temporaryName = temporaryName;
+    } else if (!isUndo) { // the entity is still under its name
+        setState(State::Failure);
+        setErrorCode(errorCode);
+    }
+
+    return isOk;
+}
+
 void PathEntity::setState(PathEntity::State state)
 {
     QWriteLocker locker(rwLock);
@@ -294,20 +465,79 @@ PathEntity::State PathEntity::state() const
     return m_state;
 }
 
-void PathEntity::findErrorCause()
+void PathEntity::setErrorCode(ErrorCode errorCode)
 {
-    Q_ASSERT(state() == State::Failure);
+    QWriteLocker locker(rwLock);
 
-    ErrorCode errorCode = ErrorCode::Unknown;
+    m_errorCode = errorCode;
+}
 
-    if (!QFileInfo::exists(fullPath()))
-        errorCode = ErrorCode::SourceNotFound;
-    else if (QFileInfo::exists(QStringLiteral("%1%2").arg(parentPath(), newName())))
-        errorCode = ErrorCode::AlreadyExist;
+// closes a cycle of renames. an entity that could not take its new name goes back to
+// restoreName, which is empty after a success.
+void PathEntity::leaveTemporaryName(const QString &restoreName, QStringView logGroup)
+{
+    if (m_temporaryName.isEmpty())
+        return;
 
-    QWriteLocker locker(rwLock);
+    if (!restoreName.isEmpty()) {
+        QSharedPointer<ParentDir> parent = m_parent.lock();
 
-    m_errorCode = errorCode;
+        const bool isOk = (renameEntry(*parent, m_temporaryName, restoreName) == ErrorCode::NoError);
+
+        QString result = isOk ? QObject::tr("SUCCEEDED")
+                              : QObject::tr("---FAILED");
+
+        QString log = QStringLiteral("%1|%2%3 -> %4").arg(result, parent->path(), m_temporaryName,
+                                                          restoreName);
+
+        ApplicationLog::instance().log(log, logGroup);
+    }
+
+    m_temporaryName.clear();
+}
+
+const PathEntity::ImageGroupEntry *PathEntity::findImageGroup(PerceptualHash::Algorithm algorithm,
+                                                              int threshold) const
+{
+    for (const ImageGroupEntry &entry : m_imageGroups) {
+        if (entry.algorithm == algorithm && entry.threshold == threshold)
+            return &entry;
+    }
+
+    return nullptr;
+}
+
+// one renameat2() on Linux, whose errno tells the cause of a failure. elsewhere, or where
+// the file system does not support it, QDir::rename and two stats for the cause.
+PathEntity::ErrorCode PathEntity::renameEntry(ParentDir &parent, const QString &name,
+                                              const QString &newName)
+{
+    switch (parent.renameEntry(name, newName)) {
+    case 0:
+        return ErrorCode::NoError;
+    case EEXIST:
+    case ENOTEMPTY:
+        return ErrorCode::AlreadyExist;
+    case ENOENT:
+        return ErrorCode::SourceNotFound;
+    case ENOSYS:
+        break;
+    default:
+        return ErrorCode::Unknown;
+    }
+
+    const QString dirPath = parent.path();
+
+    if (QDir(dirPath).rename(name, newName))
+        return ErrorCode::NoError;
+
+    if (!QFileInfo::exists(dirPath + name))
+        return ErrorCode::SourceNotFound;
+
+    if (QFileInfo::exists(dirPath + newName))
+        return ErrorCode::AlreadyExist;
+
+    return ErrorCode::Unknown;
 }
 
 } // Path
@@ -19,10 +19,15 @@
 
 #pragma once
 
-#include <QCryptographicHash>
-#include <QHash>
+#include "filehash/filedigest.h"
+#include "imagehash/imagehashalgorithm.h"
+#include "imagehash/imageheader.h"
+
 #include <QIcon>
 #include <QSharedPointer>
+#include <QVarLengthArray>
+
+#include <optional>
 
 namespace Path {
 
@@ -42,12 +47,21 @@ public:
 
     QWeakPointer<ParentDir> parent() const;
 
-    QString hashHex(QCryptographicHash::Algorithm algorithm) const;
-    QString imageHash() const;
-
-    void setHashHex(QCryptographicHash::Algorithm algorithm, QStringView hashHex);
-    void setImageHash(QStringView imageHash);
+    FileDigest fileDigest(FileHash::Algorithm algorithm) const;
+    std::optional<quint64> imageHash(PerceptualHash::Algorithm algorithm) const;
+    int duplicateGroup() const;
+    int imageGroup(PerceptualHash::Algorithm algorithm, int threshold) const;
+    int imageGroupMember(PerceptualHash::Algorithm algorithm, int threshold) const;
+    std::optional<ImageHeader> imageHeader() const;
+
+    void setFileDigest(const FileDigest &digest);
+    void setImageHash(PerceptualHash::Algorithm algorithm, quint64 imageHash);
+    void setDuplicateGroup(int group);
+    void setImageGroup(PerceptualHash::Algorithm algorithm, int threshold, int group, int member);
+    void setImageHeader(const ImageHeader &imageHeader);
     void setNewName(QStringView newName);
+    // copies the results derived from the content, from another entity of the same inode.
+    void shareContentResults(const PathEntity &source);
 
     bool checkForNewNameCollisions(QSharedPointer<PathEntity> other);
     bool checkSelfNewName();
@@ -58,8 +72,14 @@ public:
     QIcon typeIcon() const;
     QString statusText() const;
 
+    bool isReadyToRename() const;
+    bool isRenamed() const;
+
     bool rename();
     bool undoRename();
+    // moves the entity under a temporary name to open a cycle of renames. the next
+    // rename() or undoRename() starts from there.
+    bool moveAside();
 
 private:
     enum class State : int {
@@ -70,10 +90,21 @@ private:
         NoError, AlreadyExist, SourceNotFound, Unknown
     };
 
+    struct ImageGroupEntry {
+        PerceptualHash::Algorithm algorithm;
+        int threshold;
+        int group;
+        int member;
+    };
+
     void setState(State state);
     State state() const;
 
-    void findErrorCause();
+    void setErrorCode(ErrorCode errorCode);
+    void leaveTemporaryName(const QString &restoreName, QStringView logGroup);
+    const ImageGroupEntry *findImageGroup(PerceptualHash::Algorithm algorithm, int threshold) const;
+
+    static ErrorCode renameEntry(ParentDir &parent, const QString &name, const QString &newName);
 
     const bool m_isDir;
 
@@ -83,9 +114,13 @@ private:
     QWeakPointer<ParentDir> m_parent;
     QString m_name;
     QString m_newName;
+    QString m_temporaryName; // only used by the renaming thread
     QIcon m_fileIcon;
-    QHash<QCryptographicHash::Algorithm, QString> m_fileHashs;
-    QString m_imageHash;
+    QVarLengthArray<FileDigest, 1> m_fileDigests; // a chain rarely needs more than one
+    QVarLengthArray<std::pair<PerceptualHash::Algorithm, quint64>, 1> m_imageHashes;
+    int m_duplicateGroup = 0;
+    QVarLengthArray<ImageGroupEntry, 1> m_imageGroups; // one per clustering of the chain
+    std::optional<ImageHeader> m_imageHeader;
 };
 
 } // Path
@@ -22,59 +22,98 @@
 
 namespace Path {
 
-PathEntityInfo::PathEntityInfo(SharedEntity entity)
+PathEntityInfo::PathEntityInfo(PathEntity &entity)
     : m_entity(entity)
 {
-    Q_ASSERT(entity != nullptr);
 }
 
 bool PathEntityInfo::isDir() const
 {
-    return m_entity->isDir();
+    return m_entity.isDir();
 }
 
 QString PathEntityInfo::fullPath() const
 {
-    return m_entity->fullPath();
+    if (m_fullPath.isNull())
+        m_fullPath = m_entity.fullPath();
+
+    return m_fullPath;
 }
 
 QString PathEntityInfo::fileName() const
 {
-    return m_entity->name();
+    return name();
+}
+
+QStringView PathEntityInfo::completeBaseName() const
+{
+    const QString &entityName = name();
+
+    return (m_lastDotIndex == -1) ? QStringView{entityName}
+                                  : QStringView{entityName}.left(m_lastDotIndex);
+}
+
+QStringView PathEntityInfo::suffix() const
+{
+    const QString &entityName = name();
+
+    return (m_lastDotIndex == -1) ? QStringView{}
+                                  : QStringView{entityName}.sliced(m_lastDotIndex + 1);
+}
+
+FileDigest PathEntityInfo::fileDigest(FileHash::Algorithm algorithm) const
+{
+    return m_entity.fileDigest(algorithm);
+}
+
+std::optional<quint64> PathEntityInfo::imageHash(PerceptualHash::Algorithm algorithm) const
+{
+    return m_entity.imageHash(algorithm);
 }
 
-QString PathEntityInfo::completeBaseName() const
+int PathEntityInfo::duplicateGroup() const
 {
-    QString name = m_entity->name();
+    return m_entity.duplicateGroup();
+}
 
-    return name.left(name.lastIndexOf('.'));
+int PathEntityInfo::imageGroup(PerceptualHash::Algorithm algorithm, int threshold) const
+{
+    return m_entity.imageGroup(algorithm, threshold);
 }
 
-QString PathEntityInfo::suffix() const
+int PathEntityInfo::imageGroupMember(PerceptualHash::Algorithm algorithm, int threshold) const
 {
-    QString name = m_entity->name();
+    return m_entity.imageGroupMember(algorithm, threshold);
+}
 
-    return name.mid(name.lastIndexOf('.') + 1);
+std::optional<ImageHeader> PathEntityInfo::imageHeader() const
+{
+    return m_entity.imageHeader();
 }
 
-QString PathEntityInfo::hashHex(QCryptographicHash::Algorithm algorithm) const
+void PathEntityInfo::setFileDigest(const FileDigest &digest)
 {
-    return m_entity->hashHex(algorithm);
+    m_entity.setFileDigest(digest);
 }
 
-QString PathEntityInfo::imageHash() const
+void PathEntityInfo::setImageHash(PerceptualHash::Algorithm algorithm, quint64 imageHash)
 {
-    return m_entity->imageHash();
+    m_entity.setImageHash(algorithm, imageHash);
 }
 
-void PathEntityInfo::setHashHex(QCryptographicHash::Algorithm algorithm, QString hashHex)
+void PathEntityInfo::setImageHeader(const ImageHeader &imageHeader)
 {
-    m_entity->setHashHex(algorithm, hashHex);
+    m_entity.setImageHeader(imageHeader);
 }
 
-void PathEntityInfo::setImageHash(QString imageHash)
+const QString &PathEntityInfo::name() const
 {
-    m_entity->setImageHash(imageHash);
+    if (m_name.isNull()) {
+        m_name = m_entity.name(); // implicitly shared. no copy of characters.
+        m_lastDotIndex = m_name.lastIndexOf('.');
+    }
+
+    return m_name;
 }
 
 } // Path
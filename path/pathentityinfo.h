@@ -19,31 +19,44 @@
 
 #pragma once
 
-#include "usingpathentity.h"
 #include "stringbuilder/onfile/ifileinfo.h"
 
 namespace Path {
 
 class PathEntity;
 
+// Non-owning view of a PathEntity for one build. Create it on the stack.
+// Name and full path are fetched from the entity at most once.
 class PathEntityInfo : public StringBuilder::OnFile::IFileInfo
 {
+    Q_DISABLE_COPY_MOVE(PathEntityInfo)
 public:
-    PathEntityInfo(SharedEntity entity);
+    explicit PathEntityInfo(PathEntity &entity);
 
     bool isDir() const override;
     QString fullPath() const override;
     QString fileName() const override;
-    QString completeBaseName() const override;
-    QString suffix() const override;
-    QString hashHex(QCryptographicHash::Algorithm algorithm) const override;
-    QString imageHash() const override;
-
-    void setHashHex(QCryptographicHash::Algorithm algorithm, QString hashHex) override;
-    void setImageHash(QString) override;
+    QStringView completeBaseName() const override;
+    QStringView suffix() const override;
+    FileDigest fileDigest(FileHash::Algorithm algorithm) const override;
+    std::optional<quint64> imageHash(PerceptualHash::Algorithm algorithm) const override;
+    int duplicateGroup() const override;
+    int imageGroup(PerceptualHash::Algorithm algorithm, int threshold) const override;
+    int imageGroupMember(PerceptualHash::Algorithm algorithm, int threshold) const override;
+    std::optional<ImageHeader> imageHeader() const override;
+
+    void setFileDigest(const FileDigest &digest) override;
+    void setImageHash(PerceptualHash::Algorithm algorithm, quint64 imageHash) override;
+    void setImageHeader(const ImageHeader &imageHeader) override;
 
 private:
-    SharedEntity m_entity;
+    const QString &name() const;
+
+    PathEntity &m_entity;
+
+    mutable QString m_name;
+    mutable QString m_fullPath;
+    mutable qsizetype m_lastDotIndex = -1;
 };
 
 } // Path
@@ -207,7 +207,8 @@ bool PathModel::dropMimeData(const QMimeData *data, Qt::DropAction /*action*/
 }
 
 void PathModel::addPaths(QList<PathModel::ParentChildrenPair> dirs
-                       , QList<PathModel::ParentChildrenPair> files)
+                       , QList<PathModel::ParentChildrenPair> files
+                       , bool isCollapseSameInode)
 {
     if (dirs.isEmpty() && files.isEmpty())
         return;
@@ -217,7 +218,7 @@ void PathModel::addPaths(QList<PathModel::ParentChildrenPair> dirs
     beginResetModel();
 
     m_dataRoot->addDirectories(dirs);
-    m_dataRoot->addFiles(files);
+    m_dataRoot->addFiles(files, isCollapseSameInode);
 
     endResetModel();
 
@@ -73,7 +73,8 @@ public:
                     , int row, int column, const QModelIndex &parent) override;
 
     // Add/Remove data:
-    void addPaths(QList<ParentChildrenPair> dirs, QList<ParentChildrenPair> files);
+    void addPaths(QList<ParentChildrenPair> dirs, QList<ParentChildrenPair> files,
+                  bool isCollapseSameInode = false);
     void removeSpecifiedRows(QList<int> rows);
 
     bool isDir(int row) const;
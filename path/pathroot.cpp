@@ -18,10 +18,12 @@
  */
 
 #include "pathroot.h"
+#include "inodegroups.h"
 #include "parentdir.h"
 #include "pathentity.h"
 
 #include <QCollator>
+#include <QSet>
 
 namespace Path {
 
@@ -30,8 +32,11 @@ void PathRoot::addDirectories(QList<PathRoot::ParentChildrenPair> dirs)
     addPaths(dirs, EntityType::Dirs);
 }
 
-void PathRoot::addFiles(QList<PathRoot::ParentChildrenPair> files)
+void PathRoot::addFiles(QList<PathRoot::ParentChildrenPair> files, bool isCollapseSameInode)
 {
+    if (isCollapseSameInode)
+        removeRegisteredInodes(files);
+
     addPaths(files, EntityType::Files);
 }
 
@@ -118,6 +123,14 @@ QSharedPointer<ParentDir> PathRoot::dir(QStringView path) const
     return *itr;
 }
 
+void PathRoot::releaseDirHandles()
+{
+    QReadLocker locker(&m_lock);
+
+    for (const QSharedPointer<ParentDir> &dir : m_dirs)
+        dir->releaseDirHandle();
+}
+
 QSharedPointer<PathEntity> PathRoot::entity(qsizetype index) const
 {
     Q_ASSERT(uint(index) < uint(m_entities.size()));
@@ -196,4 +209,36 @@ void PathRoot::addPaths(const QList<ParentChildrenPair> &paths, EntityType entit
     }
 }
 
+// PathsAnalyzer and SearchInDirs see only the paths of one drop.
+void PathRoot::removeRegisteredInodes(QList<ParentChildrenPair> &files) const
+{
+    QSet<InodeKey> registeredInodes;
+
+    m_lock.lockForRead();
+
+    for (const QSharedPointer<PathEntity> &entity : m_entities) {
+        if (entity->isDir())
+            continue;
+
+        // symbolic links are files of their own, as in the search
+        const std::optional<InodeKey> key = inodeKeyOf(entity->fullPath(), false);
+
+        if (key.has_value())
+            registeredInodes.insert(*key);
+    }
+
+    m_lock.unlock();
+
+    if (registeredInodes.isEmpty())
+        return;
+
+    for (ParentChildrenPair &file : files) {
+        file.second.removeIf([&](const QString &name) {
+            const std::optional<InodeKey> key = inodeKeyOf(file.first + name, false);
+
+            return key.has_value() && registeredInodes.contains(*key);
+        });
+    }
+}
+
 } // Path
@@ -38,7 +38,9 @@ public:
 
     // Add / Remove / Move Data
     void addDirectories(QList<ParentChildrenPair> dirs);
-    void addFiles(QList<ParentChildrenPair> files);
+    // with isCollapseSameInode, a file already registered by an earlier drop, under the
+    // same path or a hard link, is not added again.
+    void addFiles(QList<ParentChildrenPair> files, bool isCollapseSameInode = false);
     void clear();
     void move(QList<int> sourceRows, int targetRow);
     void remove(int index, int count = 1);
@@ -50,11 +52,13 @@ public:
     bool isEmpty() const;
     void sortByEntityName(Qt::SortOrder order);
     void sortByParentDir(Qt::SortOrder order);
+    void releaseDirHandles();
 
 private:
     enum class EntityType {Dirs, Files};
 
     void addPaths(const QList<ParentChildrenPair> &paths, EntityType entityType);
+    void removeRegisteredInodes(QList<ParentChildrenPair> &files) const;
 
     mutable QReadWriteLock m_lock;
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "renameplanner.h"
+
+#include <QHash>
+
+#include <algorithm>
+
+namespace Path {
+
+RenamePlanner::RenamePlanner(const QList<QString> &sources, const QList<QString> &targets)
+{
+    Q_ASSERT(sources.size() == targets.size());
+
+    const qsizetype count = sources.size();
+
+    QHash<QString, qsizetype> sourceToIndex;
+
+    sourceToIndex.reserve(count);
+
+    for (qsizetype i = 0; i < count; ++i)
+        sourceToIndex.insert(sources.at(i), i);
+
+    // next[i] is the rename that has to leave the target of i first. -1 if the target is free
+    QList<qsizetype> next(count, -1);
+    QList<bool> hasPrevious(count, false);
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const qsizetype holder = sourceToIndex.value(targets.at(i), -1);
+
+        if (holder == -1 || holder == i)
+            continue;
+
+        next[i] = holder;
+        hasPrevious[holder] = true;
+    }
+
+    QList<bool> isPlanned(count, false);
+    QList<qsizetype> walk;
+
+    m_steps.reserve(count);
+
+    // chains, from their free end
+    for (qsizetype start = 0; start < count; ++start) {
+        if (hasPrevious.at(start))
+            continue;
+
+        walk.clear();
+
+        for (qsizetype i = start; i != -1 && !isPlanned.at(i); i = next.at(i)) {
+            isPlanned[i] = true;
+            walk.append(i);
+        }
+
+        std::for_each(walk.crbegin(), walk.crend(), [this](qsizetype i) {
+            m_steps.append({i, StepKind::Rename});
+        });
+    }
+
+    // what is left are cycles. the first entry steps aside and the others follow it.
+    for (qsizetype start = 0; start < count; ++start) {
+        if (isPlanned.at(start))
+            continue;
+
+        walk.clear();
+
+        for (qsizetype i = start; i != -1 && !isPlanned.at(i); i = next.at(i)) {
+            isPlanned[i] = true;
+            walk.append(i);
+        }
+
+        m_steps.append({start, StepKind::ToTemporary});
+
+        std::for_each(walk.crbegin(), std::prev(walk.crend()), [this](qsizetype i) {
+            m_steps.append({i, StepKind::Rename});
+        });
+
+        m_steps.append({start, StepKind::FromTemporary});
+    }
+}
+
+const QList<RenamePlanner::Step> &RenamePlanner::steps() const
+{
+    return m_steps;
+}
+
+} // Path
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QList>
+#include <QString>
+
+namespace Path {
+
+// Orders a batch of renames so that no entry is renamed onto a path that another entry of
+// the batch still holds. Since every target is unique, the renames form chains and cycles:
+// a chain a -> b -> c runs from its free end, c first, and a cycle a -> b -> c -> a parks a
+// under a temporary name first and takes it from there last. A chain of k renames costs
+// k renames and a cycle of k costs k + 1, the fewest without an exchanging rename.
+class RenamePlanner
+{
+public:
+    enum class StepKind : int {
+        Rename,        // from its path to its target
+        ToTemporary,   // from its path to a temporary name, opening a cycle
+        FromTemporary, // from the temporary name to its target, closing the cycle
+    };
+
+    struct Step
+    {
+        qsizetype index; // into the lists given to the constructor
+        StepKind kind;
+    };
+
+    // paths of the same index are one rename. the targets must be unique.
+    RenamePlanner(const QList<QString> &sources, const QList<QString> &targets);
+
+    const QList<Step> &steps() const;
+
+private:
+    QList<Step> m_steps;
+};
+
+} // Path
@@ -18,9 +18,11 @@
  */
 
 #include "pathsanalyzer.h"
+#include "path/inodegroups.h"
 
 #include <QFileInfo>
 #include <QDebug>
+#include <QSet>
 
 //#define OUTPUT_FOUND_NAMES
 
@@ -34,6 +36,8 @@ void PathsAnalyzer::analyze(const QStringList &paths)
 
     qInfo() << QObject::tr("PathsAnalyzer: start analyzing.");
 
+    QSet<Path::InodeKey> knownInodes;
+
     for (const QString &path : paths) {
         qInfo() << QObject::tr("Analyzing...[%1]").arg(path);
 
@@ -42,6 +46,18 @@ void PathsAnalyzer::analyze(const QStringList &paths)
         if (fileInfo.isRoot() || fileInfo.isRelative() || !fileInfo.exists())
             continue;
 
+        if (m_isCollapseSameInode && !fileInfo.isDir()) {
+            const std::optional<Path::InodeKey> key = Path::inodeKeyOf(path, false);
+
+            if (key.has_value() && knownInodes.contains(*key)) {
+                qInfo() << QObject::tr("[%1] is the same file as another path.").arg(path);
+                continue;
+            }
+
+            if (key.has_value())
+                knownInodes.insert(*key);
+        }
+
         qDebug() << (fileInfo.isDir() ? QObject::tr("[%1] is dir.").arg(path)
                                       : QObject::tr("[%1] is file.").arg(path));
 
@@ -68,6 +84,11 @@ void PathsAnalyzer::analyze(const QStringList &paths)
     qInfo() << QObject::tr("PathsAnalyzer: finished analyzing.");
 }
 
+void PathsAnalyzer::setCollapseSameInode(bool isCollapseSameInode)
+{
+    m_isCollapseSameInode = isCollapseSameInode;
+}
+
 QList<PathsAnalyzer::ParentChildrenPair> PathsAnalyzer::dirs() const
 {
     return m_dirs;
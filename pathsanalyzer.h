@@ -30,6 +30,8 @@ public:
     ~PathsAnalyzer() = default;
 
     void analyze(const QStringList &paths);
+    // hard links and paths given twice are listed once
+    void setCollapseSameInode(bool isCollapseSameInode);
 
     QList<ParentChildrenPair> dirs() const;
     QList<ParentChildrenPair> files() const;
@@ -39,4 +41,5 @@ public:
 private:
     QList<ParentChildrenPair> m_dirs;
     QList<ParentChildrenPair> m_files;
+    bool m_isCollapseSameInode = false;
 };
@@ -43,6 +43,7 @@ void SearchInDirs::exec(QList<ParentChildrenPair> targetDirs)
 {
     m_dirs.clear();
     m_files.clear();
+    m_knownInodes.clear();
 
     const QStringList nameFilters = m_settings.filters;
     int hierarchy = m_settings.hierarchy;
@@ -114,6 +115,9 @@ void SearchInDirs::searchForFiles(const QDir &parentDir)
 
     QStringList childrenNames = parentDir.entryList(QDir::Files | QDir::Hidden);
 
+    if (m_settings.isCollapseSameInode)
+        removeKnownInodes(addSeparator(parentDir.path()), childrenNames);
+
     if (childrenNames.isEmpty())
         return;
 
@@ -153,3 +157,20 @@ QString SearchInDirs::addSeparator(QStringView dirPath)
 
     return QString("%1/").arg(dirPath);
 }
+
+void SearchInDirs::removeKnownInodes(const QString &dirPath, QStringList &fileNames)
+{
+    fileNames.removeIf([&](const QString &fileName) {
+        // symbolic links are files of their own
+        const std::optional<Path::InodeKey> key = Path::inodeKeyOf(dirPath + fileName, false);
+
+        if (!key.has_value())
+            return false;
+
+        const qsizetype countBefore = m_knownInodes.size();
+
+        m_knownInodes.insert(*key);
+
+        return m_knownInodes.size() == countBefore;
+    });
+}
@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include "path/inodegroups.h"
+
+#include <QSet>
 #include <QStringList>
 
 class QDir;
@@ -33,6 +36,7 @@ public:
         bool isSearchFiles;
         int hierarchy;
         QStringList filters;
+        bool isCollapseSameInode; // hard links and files found twice are listed once
     };
 
     SearchInDirs(const Settings &settings);
@@ -47,9 +51,11 @@ private:
     void searchForFiles(const QDir &parentDir);
     void searchOneLayer(QList<ParentChildrenPair> &targetDirs, const QStringList &nameFilters);
     QString addSeparator(QStringView dirPath);
+    void removeKnownInodes(const QString &dirPath, QStringList &fileNames);
 
     const Settings m_settings;
 
     QList<ParentChildrenPair> m_dirs;
     QList<ParentChildrenPair> m_files;
+    QSet<Path::InodeKey> m_knownInodes;
 };
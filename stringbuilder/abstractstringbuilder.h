@@ -39,6 +39,7 @@ public:
     virtual constexpr BuilderType builderType() const = 0;
 
     virtual void build(QString &result) = 0;
+    virtual qsizetype lengthHint() const { return 0; } // chars expected to be added by build()
 
     virtual QString toHtmlString() const = 0;
     virtual void reset() {}
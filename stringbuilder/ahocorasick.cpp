@@ -0,0 +1,186 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ahocorasick.h"
+
+#include <QVarLengthArray>
+
+namespace StringBuilder {
+
+AhoCorasick::AhoCorasick()
+    : m_nodes{Node{}}
+{
+}
+
+void AhoCorasick::build(const QList<Replacement> &table, Qt::CaseSensitivity caseSensitivity)
+{
+    clear();
+
+    m_caseSensitivity = caseSensitivity;
+
+    for (const Replacement &replacement : table) {
+        const QString &keyword = replacement.first;
+
+        if (keyword.isEmpty())
+            continue;
+
+        int state = 0;
+
+        for (QChar c : keyword) {
+            const char16_t folded = fold(c);
+            auto itr = m_nodes[state].next.constFind(folded);
+
+            if (itr != m_nodes[state].next.cend()) {
+                state = itr.value();
+                continue;
+            }
+
+            m_nodes.append(Node{});
+            m_nodes[state].next.insert(folded, int(m_nodes.size() - 1));
+            state = int(m_nodes.size() - 1);
+        }
+
+        if (m_nodes[state].keyword != -1) // the first row wins for duplicated keywords
+            continue;
+
+        m_nodes[state].keyword = int(m_replacements.size());
+        m_keywordLengths.append(keyword.size());
+        m_replacements.append(replacement.second);
+    }
+
+    // breadth-first to resolve fail links from shallower nodes
+    QList<int> queue;
+
+    for (int child : std::as_const(m_nodes[0].next))
+        queue.append(child);
+
+    for (qsizetype head = 0; head < queue.size(); ++head) {
+        const int state = queue.at(head);
+
+        for (auto itr = m_nodes[state].next.cbegin(), end = m_nodes[state].next.cend();
+             itr != end; ++itr) {
+            const int child = itr.value();
+            int fail = m_nodes[state].fail;
+
+            while (fail != 0 && !m_nodes[fail].next.contains(itr.key()))
+                fail = m_nodes[fail].fail;
+
+            const int target = m_nodes[fail].next.value(itr.key(), 0);
+
+            m_nodes[child].fail = (target != child) ? target : 0;
+
+            const Node &failNode = m_nodes[m_nodes[child].fail];
+
+            m_nodes[child].dictLink = (failNode.keyword != -1) ? m_nodes[child].fail
+                                                               : failNode.dictLink;
+            queue.append(child);
+        }
+    }
+}
+
+void AhoCorasick::clear()
+{
+    m_nodes = {Node{}};
+    m_keywordLengths.clear();
+    m_replacements.clear();
+}
+
+bool AhoCorasick::isEmpty() const
+{
+    return m_replacements.isEmpty();
+}
+
+qsizetype AhoCorasick::keywordCount() const
+{
+    return m_replacements.size();
+}
+
+void AhoCorasick::replace(QString &text) const
+{
+    if (isEmpty() || text.isEmpty())
+        return;
+
+    // longest keyword starting at each position
+    QVarLengthArray<int, 256> longest(text.size());
+    std::fill(longest.begin(), longest.end(), -1);
+    bool isFound = false;
+    int state = 0;
+
+    for (qsizetype i = 0, size = text.size(); i < size; ++i) {
+        state = nextState(state, fold(text.at(i)));
+
+        int output = (m_nodes.at(state).keyword != -1) ? state : m_nodes.at(state).dictLink;
+
+        for (; output != -1; output = m_nodes.at(output).dictLink) {
+            const int keyword = m_nodes.at(output).keyword;
+            const qsizetype start = i - m_keywordLengths.at(keyword) + 1;
+
+            if (longest[start] == -1
+                    || m_keywordLengths.at(longest[start]) < m_keywordLengths.at(keyword)) {
+                longest[start] = keyword;
+            }
+
+            isFound = true;
+        }
+    }
+
+    if (!isFound)
+        return;
+
+    static thread_local QString result; // swapped with text to keep both capacities.
+
+    result.resize(0);
+    result.reserve(text.size());
+
+    for (qsizetype i = 0, size = text.size(); i < size;) {
+        const int keyword = longest[i];
+
+        if (keyword == -1) {
+            result.append(text.at(i++));
+            continue;
+        }
+
+        result.append(m_replacements.at(keyword));
+        i += m_keywordLengths.at(keyword);
+    }
+
+    text.swap(result);
+}
+
+char16_t AhoCorasick::fold(QChar c) const
+{
+    return (m_caseSensitivity == Qt::CaseSensitive) ? c.unicode() : c.toCaseFolded().unicode();
+}
+
+int AhoCorasick::nextState(int state, char16_t c) const
+{
+    forever {
+        auto itr = m_nodes.at(state).next.constFind(c);
+
+        if (itr != m_nodes.at(state).next.cend())
+            return itr.value();
+
+        if (state == 0)
+            return 0;
+
+        state = m_nodes.at(state).fail;
+    }
+}
+
+} // StringBuilder
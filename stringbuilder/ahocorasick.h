@@ -0,0 +1,62 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+namespace StringBuilder {
+
+// Aho-Corasick automaton for replacing many keywords in a single pass.
+// Overlapping matches are resolved leftmost-longest.
+class AhoCorasick
+{
+public:
+    using Replacement = QPair<QString, QString>;
+
+    AhoCorasick();
+
+    void build(const QList<Replacement> &table, Qt::CaseSensitivity caseSensitivity);
+    void clear();
+
+    bool isEmpty() const;
+    qsizetype keywordCount() const;
+
+    void replace(QString &text) const;
+
+private:
+    struct Node {
+        QHash<char16_t, int> next;
+        int fail = 0;
+        int dictLink = -1; // nearest node on the fail chain that ends a keyword
+        int keyword = -1;
+    };
+
+    char16_t fold(QChar c) const;
+    int nextState(int state, char16_t c) const;
+
+    Qt::CaseSensitivity m_caseSensitivity = Qt::CaseSensitive;
+    QList<Node> m_nodes;
+    QList<qsizetype> m_keywordLengths;
+    QList<QString> m_replacements;
+};
+
+} // StringBuilder
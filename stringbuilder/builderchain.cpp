@@ -27,9 +27,17 @@ void BuilderChain::addBuilder(QSharedPointer<AbstractStringBuilder> builder)
     m_builders.append(builder);
 }
 
-QString BuilderChain::build()
+QStringView BuilderChain::build()
 {
-    QString result;
+    static thread_local QString result; // reused to keep its capacity.
+
+    qsizetype lengthHint = 0;
+
+    for (const QSharedPointer<AbstractStringBuilder> &builder : std::as_const(m_builders))
+        lengthHint += builder->lengthHint();
+
+    result.resize(0);
+    result.reserve(lengthHint);
 
     for (QSharedPointer<AbstractStringBuilder> &builder : m_builders)
         builder->build(result);
@@ -34,7 +34,8 @@ public:
     using QObject::QObject;
 
     virtual void addBuilder(QSharedPointer<AbstractStringBuilder> builder);
-    virtual QString build();
+    // The view is valid until the next build() on the same thread.
+    virtual QStringView build();
 
     bool isEmpty() const;
     void reset();
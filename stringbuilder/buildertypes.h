@@ -26,12 +26,13 @@
 namespace StringBuilder {
 
 enum class BuilderType : int {
-    OriginalName, InsertText, ReplaceText, Number, FileHash, ImageHash
+    OriginalName, InsertText, ReplaceText, Number, FileHash, ImageHash, ReplaceTable,
+    DuplicateGroup, ImageGroup, ImageDimensions
 };
 
 constexpr int builderTypeCount()
 {
-    return 6;
+    return 10;
 }
 
 inline QString builderName(BuilderType builderType)
@@ -43,6 +44,10 @@ inline QString builderName(BuilderType builderType)
         {BuilderType::Number, QObject::tr("Number")},
         {BuilderType::FileHash, QObject::tr("File Hash")},
         {BuilderType::ImageHash, QObject::tr("Image Hash")},
+        {BuilderType::ReplaceTable, QObject::tr("Replace Table")},
+        {BuilderType::DuplicateGroup, QObject::tr("Duplicate Group")},
+        {BuilderType::ImageGroup, QObject::tr("Similar Image Group")},
+        {BuilderType::ImageDimensions, QObject::tr("Image Dimensions")},
     };
 
     return names[builderType];
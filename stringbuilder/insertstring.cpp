@@ -46,6 +46,11 @@ void InsertString::build(QString &result)
     result.insert(actualInsertPosition(result.size()), m_string);
 }
 
+qsizetype InsertString::lengthHint() const
+{
+    return m_string.size();
+}
+
 QString InsertString::toHtmlString() const
 {
     const QString text = m_string.isEmpty()
@@ -36,6 +36,7 @@ public:
     }
 
     void build(QString &result) override;
+    qsizetype lengthHint() const override;
     QString toHtmlString() const override;
     AbstractWidget *settingsWidget() override;
 
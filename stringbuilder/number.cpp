@@ -18,6 +18,7 @@
  */
 
 #include "number.h"
+#include "utilitysformat.h"
 #include "utilityshtml.h"
 #include "widgets/widgetnumbersetting.h"
 
@@ -53,16 +54,23 @@ Number::Number(int pos, int start, int step, int digit, QStringView prefix, QStr
 
 void Number::build(QString &result)
 {
-    QString numberString = QStringLiteral("%1%2%3")
-                           .arg(m_prefix)
-                           .arg(m_currentNumber, m_digit, 10, QLatin1Char('0'))
-                           .arg(m_suffix);
+    Format::DecimalBuffer buffer;
 
-    result.insert(actualInsertPosition(result.size()), numberString);
+    const QStringView number = Format::decimal(m_currentNumber, m_digit, buffer);
+    const qsizetype pos = actualInsertPosition(result.size());
+
+    result.insert(pos, m_suffix);
+    result.insert(pos, number);
+    result.insert(pos, m_prefix);
 
     m_currentNumber += m_step;
 }
 
+qsizetype Number::lengthHint() const
+{
+    return m_prefix.size() + qMax(m_digit, 11) + m_suffix.size();
+}
+
 QString Number::toHtmlString() const
 {
     const QString baseText = tr("<b>Number</b> <i>%1%2%3</i>&nbsp;&nbsp;[Step:%4]")
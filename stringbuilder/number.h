@@ -37,6 +37,7 @@ public:
     }
 
     void build(QString &result) override;
+    qsizetype lengthHint() const override;
     QString toHtmlString() const override;
     void reset() override;
     AbstractWidget *settingsWidget() override;
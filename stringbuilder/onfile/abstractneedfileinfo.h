@@ -21,8 +21,6 @@
 
 #include "stringbuilder/abstractinsertstring.h"
 
-#include <QSharedPointer>
-
 namespace StringBuilder {
 namespace OnFile {
 
@@ -34,17 +32,16 @@ class AbstractNeedFileInfo : public StringBuilder::AbstractInsertString
 public:
     using AbstractInsertString::AbstractInsertString;
 
-    void setFileInfo(QSharedPointer<IFileInfo> fileInfo)
+    void setFileInfo(IFileInfo *fileInfo)
     {
-        if (m_fileInfo !=fileInfo)
-            m_fileInfo = fileInfo;
+        m_fileInfo = fileInfo;
     }
 
 signals:
     void needFileInfo(StringBuilder::OnFile::AbstractNeedFileInfo *stringBuilder);
 
 protected:
-    QSharedPointer<IFileInfo> m_fileInfo;
+    IFileInfo *m_fileInfo = nullptr; // not owned. valid only while building.
 };
 
 } // OnFile
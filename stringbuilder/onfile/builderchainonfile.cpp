@@ -19,8 +19,16 @@
 
 #include "builderchainonfile.h"
 #include "abstractneedfileinfo.h"
+#include "cryptographichash.h"
+#include "duplicategroup.h"
+#include "imagedimensions.h"
+#include "imagegroup.h"
+#include "imagehash.h"
+#include "filehash/filehashcalculator.h"
 #include "path/pathentity.h"
 
+#include <optional>
+
 namespace StringBuilder {
 namespace OnFile {
 
@@ -36,10 +44,92 @@ void BuilderChainOnFile::addBuilder(QSharedPointer<StringBuilder::AbstractString
     BuilderChain::addBuilder(builder);
 }
 
-void BuilderChainOnFile::setFileInfo(QSharedPointer<IFileInfo> fileInfo)
+void BuilderChainOnFile::setFileInfo(IFileInfo *fileInfo)
+{
+    m_fileInfo = fileInfo;
+}
+
+QList<FileHash::Algorithm> BuilderChainOnFile::fileHashAlgorithms() const
+{
+    QList<FileHash::Algorithm> algorithms;
+
+    for (const QSharedPointer<AbstractStringBuilder> &builder : m_builders) {
+        auto fileHash = qobject_cast<CryptographicHash *>(builder.get());
+
+        if (fileHash == nullptr || fileHash->isSampled())
+            continue;
+
+        if (!algorithms.contains(fileHash->algorithm()))
+            algorithms.append(fileHash->algorithm());
+    }
+
+    return algorithms;
+}
+
+QList<PerceptualHash::Algorithm> BuilderChainOnFile::imageHashAlgorithms() const
+{
+    QList<PerceptualHash::Algorithm> algorithms;
+
+    for (const QSharedPointer<AbstractStringBuilder> &builder : m_builders) {
+        std::optional<PerceptualHash::Algorithm> algorithm;
+
+        if (auto imageHash = qobject_cast<ImageHash *>(builder.get()))
+            algorithm = imageHash->algorithm();
+        else if (auto imageGroup = qobject_cast<ImageGroup *>(builder.get()))
+            algorithm = imageGroup->algorithm();
+
+        if (algorithm.has_value() && !algorithms.contains(*algorithm))
+            algorithms.append(*algorithm);
+    }
+
+    return algorithms;
+}
+
+bool BuilderChainOnFile::isFileContentNeeded() const
+{
+    return std::any_of(m_builders.cbegin(), m_builders.cend(),
+                       [](const QSharedPointer<AbstractStringBuilder> &builder) {
+        return qobject_cast<CryptographicHash *>(builder.get()) != nullptr
+               || qobject_cast<ImageHash *>(builder.get()) != nullptr
+               || qobject_cast<DuplicateGroup *>(builder.get()) != nullptr
+               || qobject_cast<ImageGroup *>(builder.get()) != nullptr
+               || qobject_cast<ImageDimensions *>(builder.get()) != nullptr;
+    });
+}
+
+bool BuilderChainOnFile::isDuplicateGroupNeeded() const
+{
+    return std::any_of(m_builders.cbegin(), m_builders.cend(),
+                       [](const QSharedPointer<AbstractStringBuilder> &builder) {
+        return qobject_cast<DuplicateGroup *>(builder.get()) != nullptr;
+    });
+}
+
+bool BuilderChainOnFile::isImageHeaderNeeded() const
 {
-    if (m_fileInfo != fileInfo)
-        m_fileInfo = fileInfo;
+    return std::any_of(m_builders.cbegin(), m_builders.cend(),
+                       [](const QSharedPointer<AbstractStringBuilder> &builder) {
+        return qobject_cast<ImageDimensions *>(builder.get()) != nullptr;
+    });
+}
+
+QList<std::pair<PerceptualHash::Algorithm, int>> BuilderChainOnFile::imageClusterings() const
+{
+    QList<std::pair<PerceptualHash::Algorithm, int>> clusterings;
+
+    for (const QSharedPointer<AbstractStringBuilder> &builder : m_builders) {
+        auto imageGroup = qobject_cast<ImageGroup *>(builder.get());
+
+        if (imageGroup == nullptr)
+            continue;
+
+        const std::pair clustering{imageGroup->algorithm(), imageGroup->threshold()};
+
+        if (!clusterings.contains(clustering))
+            clusterings.append(clustering);
+    }
+
+    return clusterings;
 }
 
 void BuilderChainOnFile::onNeedFileInfo(AbstractNeedFileInfo *stringBuilder)
@@ -47,6 +137,28 @@ void BuilderChainOnFile::onNeedFileInfo(AbstractNeedFileInfo *stringBuilder)
     Q_ASSERT(m_fileInfo != nullptr);
 
     stringBuilder->setFileInfo(m_fileInfo);
+
+    if (qobject_cast<CryptographicHash *>(stringBuilder) != nullptr)
+        prepareFileHashes();
+}
+
+void BuilderChainOnFile::prepareFileHashes()
+{
+    // every FileHash builder of the chain shares one read of the file.
+    QList<FileHash::Algorithm> missingAlgorithms;
+
+    for (FileHash::Algorithm algorithm : fileHashAlgorithms()) {
+        if (m_fileInfo->fileDigest(algorithm).isEmpty())
+            missingAlgorithms.append(algorithm);
+    }
+
+    if (missingAlgorithms.isEmpty())
+        return;
+
+    FileHashCalculator fileHash(m_fileInfo->fullPath());
+
+    for (const FileDigest &digest : fileHash.results(missingAlgorithms))
+        m_fileInfo->setFileDigest(digest);
 }
 
 } // OnFile
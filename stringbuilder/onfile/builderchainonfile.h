@@ -20,6 +20,8 @@
 #pragma once
 
 #include "stringbuilder/builderchain.h"
+#include "filehash/filehashalgorithm.h"
+#include "imagehash/imagehashalgorithm.h"
 
 namespace StringBuilder {
 namespace OnFile {
@@ -34,13 +36,23 @@ public:
     using BuilderChain::BuilderChain;
 
     void addBuilder(QSharedPointer<StringBuilder::AbstractStringBuilder> builder) override;
-    void setFileInfo(QSharedPointer<IFileInfo> fileInfo);
+    void setFileInfo(IFileInfo *fileInfo);
+
+    QList<FileHash::Algorithm> fileHashAlgorithms() const;
+    QList<PerceptualHash::Algorithm> imageHashAlgorithms() const;
+    bool isFileContentNeeded() const;
+    bool isDuplicateGroupNeeded() const;
+    bool isImageHeaderNeeded() const;
+    // the distinct algorithm and threshold pairs of the ImageGroup builders
+    QList<std::pair<PerceptualHash::Algorithm, int>> imageClusterings() const;
 
 private slots:
     void onNeedFileInfo(StringBuilder::OnFile::AbstractNeedFileInfo *stringBuilder);
 
 private:
-    QSharedPointer<IFileInfo> m_fileInfo;
+    void prepareFileHashes();
+
+    IFileInfo *m_fileInfo = nullptr;
 };
 
 } // OnFile
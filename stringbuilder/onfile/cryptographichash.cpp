@@ -19,11 +19,11 @@
 
 #include "cryptographichash.h"
 #include "ifileinfo.h"
+#include "filehash/filehashcalculator.h"
 #include "stringbuilder/widgets/widgetfilehashsetting.h"
 #include "utilityshtml.h"
+#include "utilitysformat.h"
 
-#include <QFile>
-#include <QMetaEnum>
 #include <QSettings>
 
 namespace StringBuilder {
@@ -32,17 +32,38 @@ namespace OnFile {
 namespace Settings {
 constexpr char groupName[] = "FileHash";
 constexpr char keyAlgorithm[] = "keyAlgorithm";
+constexpr char keySampleCount[] = "SampleCount";
 } // Settings
 
+namespace {
+
+// a hand-edited or outdated ini may name an unknown algorithm or one whose digest,
+// e.g. SHA-512, does not fit in a FileDigest.
+bool isUsable(FileHash::Algorithm algorithm)
+{
+    return !FileHash::algorithmName(algorithm).isEmpty()
+           && FileHash::digestLength(algorithm) > 0
+           && FileHash::digestLength(algorithm) <= FileDigest::maxSize;
+}
+
+} // anonymous
+
 CryptographicHash::CryptographicHash()
-    : CryptographicHash(QCryptographicHash::Md5, 0, nullptr)
+    : CryptographicHash(FileHash::Algorithm::Md5, 0, nullptr)
 {
 }
 
-CryptographicHash::CryptographicHash(QCryptographicHash::Algorithm algorithm, int pos,
+CryptographicHash::CryptographicHash(FileHash::Algorithm algorithm, int pos,
+                                     QObject *parent)
+    : CryptographicHash(algorithm, 0, pos, parent)
+{
+}
+
+CryptographicHash::CryptographicHash(FileHash::Algorithm algorithm, int sampleCount, int pos,
                                      QObject *parent)
     : AbstractNeedFileInfo{pos, parent},
-      m_algorithm{algorithm}
+      m_algorithm{algorithm},
+      m_sampleCount{qMax(0, sampleCount)}
 {
 }
 
@@ -50,32 +71,55 @@ void CryptographicHash::build(QString &result)
 {
     emit needFileInfo(this);
 
-    QString hashHex = m_fileInfo->hashHex(m_algorithm);
+    FileDigest digest;
 
-    if (hashHex.isEmpty()) {
-        QFile file(m_fileInfo->fullPath());
+    if (isSampled()) {
+        // not stored to the entity. it differs from the hash of the whole file.
+        FileHashCalculator fileHash(m_fileInfo->fullPath());
 
-        if (!file.open(QFile::ReadOnly))
-            return;
+        digest = fileHash.sampledResult(m_algorithm, m_sampleCount);
+    } else {
+        digest = m_fileInfo->fileDigest(m_algorithm);
 
-        QCryptographicHash hash(m_algorithm);
+        if (digest.isEmpty()) {
+            FileHashCalculator fileHash(m_fileInfo->fullPath());
 
-        if (!hash.addData(&file))
-            return;
+            digest = fileHash.result(m_algorithm);
 
-        hashHex = hash.result().toHex();
-
-        m_fileInfo->setHashHex(m_algorithm, hashHex);
+            if (!digest.isEmpty())
+                m_fileInfo->setFileDigest(digest);
+        }
     }
 
-    result.insert(actualInsertPosition(result.size()), hashHex);
+    if (digest.isEmpty())
+        return;
+
+    Format::HexBuffer buffer;
+
+    result.insert(actualInsertPosition(result.size()), Format::hex(digest.bytes(), buffer));
 }
 
-QString CryptographicHash::toHtmlString() const
+FileHash::Algorithm CryptographicHash::algorithm() const
+{
+    return m_algorithm;
+}
+
+bool CryptographicHash::isSampled() const
 {
-    auto metaEnum = QMetaEnum::fromType<QCryptographicHash::Algorithm>();
+    return m_sampleCount > 0;
+}
 
-    const char *algorithmName = metaEnum.valueToKey(m_algorithm);
+qsizetype CryptographicHash::lengthHint() const
+{
+    return FileHash::digestLength(m_algorithm) * 2;
+}
+
+QString CryptographicHash::toHtmlString() const
+{
+    const QString algorithmName = isSampled()
+            ? QStringLiteral("%1 sampled x%2").arg(FileHash::algorithmName(m_algorithm))
+                                              .arg(m_sampleCount)
+            : FileHash::algorithmName(m_algorithm);
 
     if (isLeftMost())
         return Html::leftAligned(QStringLiteral("&lt;&lt; <b>%1</b>").arg(algorithmName));
@@ -89,12 +133,13 @@ QString CryptographicHash::toHtmlString() const
 
 AbstractWidget *CryptographicHash::settingsWidget()
 {
-    auto widget = new WidgetFileHashSetting(m_algorithm, insertPosition());
+    auto widget = new WidgetFileHashSetting(m_algorithm, m_sampleCount, insertPosition());
 
     connect(widget, &AbstractWidget::accepted, this, [&, this]() {
         auto settingsWidget = qobject_cast<WidgetFileHashSetting *>(sender());
 
         m_algorithm = settingsWidget->algorithm();
+        m_sampleCount = settingsWidget->sampleCount();
         setInsertPosition(settingsWidget->insertPosition());
     });
 
@@ -105,9 +150,11 @@ void CryptographicHash::loadSettings(QSettings *qSet)
 {
     qSet->beginGroup(Settings::groupName);
 
-    QVariant value = qSet->value(Settings::keyAlgorithm, int(QCryptographicHash::Md5)).toInt();
+    const int value = qSet->value(Settings::keyAlgorithm, int(FileHash::Algorithm::Md5)).toInt();
 
-    m_algorithm = value.value<QCryptographicHash::Algorithm>();
+    m_algorithm = isUsable(FileHash::Algorithm(value)) ? FileHash::Algorithm(value)
+                                                       : FileHash::Algorithm::Md5;
+    m_sampleCount = qMax(0, qSet->value(Settings::keySampleCount, 0).toInt());
 
     AbstractInsertString::loadSettings(qSet);
 
@@ -119,6 +166,7 @@ void CryptographicHash::saveSettings(QSettings *qSet) const
     qSet->beginGroup(Settings::groupName);
 
     qSet->setValue(Settings::keyAlgorithm, int(m_algorithm));
+    qSet->setValue(Settings::keySampleCount, m_sampleCount);
     AbstractInsertString::saveSettings(qSet);
 
     qSet->endGroup();
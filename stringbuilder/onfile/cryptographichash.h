@@ -20,8 +20,7 @@
 #pragma once
 
 #include "abstractneedfileinfo.h"
-
-#include <QCryptographicHash>
+#include "filehash/filehashalgorithm.h"
 
 namespace StringBuilder {
 namespace OnFile {
@@ -31,7 +30,9 @@ class CryptographicHash : public AbstractNeedFileInfo
     Q_OBJECT
 public:
     CryptographicHash();
-    CryptographicHash(QCryptographicHash::Algorithm algorithm, int pos, QObject *parent = nullptr);
+    CryptographicHash(FileHash::Algorithm algorithm, int pos, QObject *parent = nullptr);
+    CryptographicHash(FileHash::Algorithm algorithm, int sampleCount, int pos,
+                      QObject *parent = nullptr);
 
     constexpr BuilderType builderType() const override
     {
@@ -39,14 +40,19 @@ public:
     }
 
     void build(QString &result) override;
+    qsizetype lengthHint() const override;
     QString toHtmlString() const override;
     AbstractWidget *settingsWidget() override;
 
     void loadSettings(QSettings *qSet) override;
     void saveSettings(QSettings *qSet) const override;
 
+    FileHash::Algorithm algorithm() const;
+    bool isSampled() const;
+
 private:
-    QCryptographicHash::Algorithm m_algorithm;
+    FileHash::Algorithm m_algorithm;
+    int m_sampleCount = 0; // 0 means the whole file
 };
 
 } // OnFile
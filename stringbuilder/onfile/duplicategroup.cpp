@@ -0,0 +1,119 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "duplicategroup.h"
+#include "ifileinfo.h"
+#include "stringbuilder/widgets/widgetduplicategroupsetting.h"
+#include "utilitysformat.h"
+#include "utilityshtml.h"
+
+#include <QSettings>
+
+namespace StringBuilder {
+namespace OnFile {
+
+namespace Settings {
+constexpr char groupName[] = "DuplicateGroup";
+constexpr char keyPrefix[] = "Prefix";
+constexpr char defaultPrefix[] = "_dup";
+} // Settings
+
+DuplicateGroup::DuplicateGroup()
+    : DuplicateGroup(0, QString::fromLatin1(Settings::defaultPrefix), nullptr)
+{
+}
+
+DuplicateGroup::DuplicateGroup(int pos, QStringView prefix, QObject *parent)
+    : AbstractNeedFileInfo{pos, parent},
+      m_prefix{prefix.toString()}
+{
+}
+
+void DuplicateGroup::build(QString &result)
+{
+    emit needFileInfo(this);
+
+    // grouped by ThreadCreateNewNames before any name is built
+    const int group = m_fileInfo->duplicateGroup();
+
+    if (group == 0)
+        return;
+
+    Format::DecimalBuffer buffer;
+
+    const QStringView number = Format::decimal(group, 0, buffer);
+    const qsizetype pos = actualInsertPosition(result.size());
+
+    result.insert(pos, number);
+    result.insert(pos, m_prefix);
+}
+
+qsizetype DuplicateGroup::lengthHint() const
+{
+    return m_prefix.size() + 4;
+}
+
+QString DuplicateGroup::toHtmlString() const
+{
+    const QString text = tr("<b>Duplicate Group</b> <i>%1N</i>").arg(m_prefix);
+
+    if (isLeftMost())
+        return Html::leftAligned(QStringLiteral("&lt;&lt; %1").arg(text));
+
+    if (isRightMost())
+        return Html::rightAligned(QStringLiteral("%1 &gt;&gt;").arg(text));
+
+    return Html::leftAligned(QStringLiteral("__%1__ %2").arg(insertPosition()).arg(text));
+}
+
+AbstractWidget *DuplicateGroup::settingsWidget()
+{
+    auto widget = new WidgetDuplicateGroupSetting(m_prefix, insertPosition());
+
+    connect(widget, &AbstractWidget::accepted, this, [&, this]() {
+        auto settingsWidget = qobject_cast<WidgetDuplicateGroupSetting *>(sender());
+
+        m_prefix = settingsWidget->prefix();
+        setInsertPosition(settingsWidget->insertPosition());
+    });
+
+    return widget;
+}
+
+void DuplicateGroup::loadSettings(QSettings *qSet)
+{
+    qSet->beginGroup(Settings::groupName);
+
+    m_prefix = qSet->value(Settings::keyPrefix, QString::fromLatin1(Settings::defaultPrefix)).toString();
+    AbstractInsertString::loadSettings(qSet);
+
+    qSet->endGroup();
+}
+
+void DuplicateGroup::saveSettings(QSettings *qSet) const
+{
+    qSet->beginGroup(Settings::groupName);
+
+    qSet->setValue(Settings::keyPrefix, m_prefix);
+    AbstractInsertString::saveSettings(qSet);
+
+    qSet->endGroup();
+}
+
+} // OnFile
+} // StringBuilder
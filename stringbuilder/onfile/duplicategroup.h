@@ -0,0 +1,53 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "abstractneedfileinfo.h"
+
+namespace StringBuilder {
+namespace OnFile {
+
+// Inserts the prefix and the duplicate group number, e.g. "_dup3", to files whose content
+// is shared with another file. Files of unique content get nothing.
+class DuplicateGroup : public AbstractNeedFileInfo
+{
+    Q_OBJECT
+public:
+    DuplicateGroup();
+    DuplicateGroup(int pos, QStringView prefix, QObject *parent = nullptr);
+
+    constexpr BuilderType builderType() const override
+    {
+        return BuilderType::DuplicateGroup;
+    }
+
+    void build(QString &result) override;
+    qsizetype lengthHint() const override;
+    QString toHtmlString() const override;
+    AbstractWidget *settingsWidget() override;
+
+    void loadSettings(QSettings *qSet) override;
+    void saveSettings(QSettings *qSet) const override;
+
+private:
+    QString m_prefix;
+};
+
+} // OnFile
+} // StringBuilder
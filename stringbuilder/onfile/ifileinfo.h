@@ -19,9 +19,14 @@
 
 #pragma once
 
-#include <QCryptographicHash>
+#include "filehash/filedigest.h"
+#include "imagehash/imagehashalgorithm.h"
+#include "imagehash/imageheader.h"
+
 #include <QString>
 
+#include <optional>
+
 namespace StringBuilder {
 namespace OnFile {
 
@@ -34,13 +39,20 @@ public:
     virtual bool isDir() const = 0;
     virtual QString fullPath() const = 0;
     virtual QString fileName() const = 0;
-    virtual QString completeBaseName() const = 0;
-    virtual QString suffix() const = 0;
-    virtual QString hashHex(QCryptographicHash::Algorithm algorithm) const = 0;
-    virtual QString imageHash() const = 0;
+    // views are valid while this IFileInfo lives.
+    virtual QStringView completeBaseName() const = 0;
+    virtual QStringView suffix() const = 0;
+    virtual FileDigest fileDigest(FileHash::Algorithm algorithm) const = 0;
+    virtual std::optional<quint64> imageHash(PerceptualHash::Algorithm algorithm) const = 0;
+    virtual int duplicateGroup() const = 0; // 0 if the content is unique
+    // by the algorithm and the threshold of the ImageGroup builder. 0 if no similar image
+    virtual int imageGroup(PerceptualHash::Algorithm algorithm, int threshold) const = 0;
+    virtual int imageGroupMember(PerceptualHash::Algorithm algorithm, int threshold) const = 0;
+    virtual std::optional<ImageHeader> imageHeader() const = 0; // nullopt if not read yet
 
-    virtual void setHashHex(QCryptographicHash::Algorithm algorithm, QString hashHex) = 0;
-    virtual void setImageHash(QString) = 0;
+    virtual void setFileDigest(const FileDigest &digest) = 0;
+    virtual void setImageHash(PerceptualHash::Algorithm algorithm, quint64 imageHash) = 0;
+    virtual void setImageHeader(const ImageHeader &imageHeader) = 0;
 };
 
 } // OnFile
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "imagedimensions.h"
+#include "ifileinfo.h"
+#include "stringbuilder/widgets/widgetimagedimensionssetting.h"
+#include "utilitysformat.h"
+#include "utilityshtml.h"
+
+#include <QSettings>
+
+namespace StringBuilder {
+namespace OnFile {
+
+namespace Settings {
+constexpr char groupName[] = "ImageDimensions";
+constexpr char keyTemplate[] = "Template";
+constexpr char defaultTemplate[] = "_%wx%h";
+} // Settings
+
+ImageDimensions::ImageDimensions()
+    : ImageDimensions(0, QString::fromLatin1(Settings::defaultTemplate), nullptr)
+{
+}
+
+ImageDimensions::ImageDimensions(int pos, QStringView textTemplate, QObject *parent)
+    : AbstractNeedFileInfo{pos, parent},
+      m_template{textTemplate.toString()}
+{
+}
+
+void ImageDimensions::build(QString &result)
+{
+    emit needFileInfo(this);
+
+    if (m_fileInfo->isDir())
+        return;
+
+    std::optional<ImageHeader> header = m_fileInfo->imageHeader();
+
+    // read by ThreadCreateNewNames before the name is built, unless the chain runs alone
+    if (!header.has_value()) {
+        header = ImageHeader::read(m_fileInfo->fullPath());
+        m_fileInfo->setImageHeader(*header);
+    }
+
+    if (!header->isValid())
+        return;
+
+    Format::DecimalBuffer buffer;
+
+    const QStringView textTemplate{m_template};
+    qsizetype pos = actualInsertPosition(result.size());
+    qsizetype literalFirst = 0;
+
+    auto insert = [&result, &pos](auto text) {
+        result.insert(pos, text);
+        pos += text.size();
+    };
+
+    // the text between the fields is inserted as it is
+    for (qsizetype i = 0, count = textTemplate.size(); i + 1 < count; ++i) {
+        const QChar field = textTemplate.at(i + 1);
+
+        if (textTemplate.at(i) != u'%' || (field != u'w' && field != u'h' && field != u'f'))
+            continue;
+
+        insert(textTemplate.sliced(literalFirst, i - literalFirst));
+
+        if (field == u'w')
+            insert(Format::decimal(header->size.width(), 0, buffer));
+        else if (field == u'h')
+            insert(Format::decimal(header->size.height(), 0, buffer));
+        else
+            insert(QLatin1String(header->format));
+
+        literalFirst = i + 2;
+        ++i;
+    }
+
+    insert(textTemplate.sliced(literalFirst));
+}
+
+qsizetype ImageDimensions::lengthHint() const
+{
+    return m_template.size() + 8;
+}
+
+QString ImageDimensions::toHtmlString() const
+{
+    const QString text = tr("<b>Image Dimensions</b> <i>%1</i>").arg(m_template.toHtmlEscaped());
+
+    if (isLeftMost())
+        return Html::leftAligned(QStringLiteral("&lt;&lt; %1").arg(text));
+
+    if (isRightMost())
+        return Html::rightAligned(QStringLiteral("%1 &gt;&gt;").arg(text));
+
+    return Html::leftAligned(QStringLiteral("__%1__ %2").arg(insertPosition()).arg(text));
+}
+
+AbstractWidget *ImageDimensions::settingsWidget()
+{
+    auto widget = new WidgetImageDimensionsSetting(m_template, insertPosition());
+
+    connect(widget, &AbstractWidget::accepted, this, [&, this]() {
+        auto settingsWidget = qobject_cast<WidgetImageDimensionsSetting *>(sender());
+
+        m_template = settingsWidget->textTemplate();
+        setInsertPosition(settingsWidget->insertPosition());
+    });
+
+    return widget;
+}
+
+void ImageDimensions::loadSettings(QSettings *qSet)
+{
+    qSet->beginGroup(Settings::groupName);
+
+    m_template = qSet->value(Settings::keyTemplate,
+                             QString::fromLatin1(Settings::defaultTemplate)).toString();
+    AbstractInsertString::loadSettings(qSet);
+
+    qSet->endGroup();
+}
+
+void ImageDimensions::saveSettings(QSettings *qSet) const
+{
+    qSet->beginGroup(Settings::groupName);
+
+    qSet->setValue(Settings::keyTemplate, m_template);
+    AbstractInsertString::saveSettings(qSet);
+
+    qSet->endGroup();
+}
+
+} // OnFile
+} // StringBuilder
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "abstractneedfileinfo.h"
+
+namespace StringBuilder {
+namespace OnFile {
+
+// Inserts the size and the format of images, read from their headers, through a template
+// such as "_%wx%h": %w is the width, %h the height and %f the format. Other files get nothing.
+class ImageDimensions : public AbstractNeedFileInfo
+{
+    Q_OBJECT
+public:
+    ImageDimensions();
+    ImageDimensions(int pos, QStringView textTemplate, QObject *parent = nullptr);
+
+    constexpr BuilderType builderType() const override
+    {
+        return BuilderType::ImageDimensions;
+    }
+
+    void build(QString &result) override;
+    qsizetype lengthHint() const override;
+    QString toHtmlString() const override;
+    AbstractWidget *settingsWidget() override;
+
+    void loadSettings(QSettings *qSet) override;
+    void saveSettings(QSettings *qSet) const override;
+
+private:
+    QString m_template;
+};
+
+} // OnFile
+} // StringBuilder
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "imagegroup.h"
+#include "ifileinfo.h"
+#include "imagehash/imageclusterfinder.h"
+#include "stringbuilder/widgets/widgetimagegroupsetting.h"
+#include "utilitysformat.h"
+#include "utilityshtml.h"
+
+#include <QSettings>
+
+namespace StringBuilder {
+namespace OnFile {
+
+namespace Settings {
+constexpr char groupName[] = "ImageGroup";
+constexpr char keyAlgorithm[] = "Algorithm";
+constexpr char keyThreshold[] = "Threshold";
+constexpr char keyPrefix[] = "Prefix";
+constexpr char defaultPrefix[] = "group";
+constexpr int defaultThreshold = 10;
+} // Settings
+
+namespace {
+
+// a hand-edited or outdated ini may name an unknown algorithm
+bool isUsable(PerceptualHash::Algorithm algorithm)
+{
+    return !PerceptualHash::algorithmName(algorithm).isEmpty();
+}
+
+// the clustering caps the threshold, so the builder shows the value actually used
+int usableThreshold(int threshold)
+{
+    return qBound(0, threshold, ImageClusterFinder::maxThreshold);
+}
+
+} // anonymous
+
+ImageGroup::ImageGroup()
+    : ImageGroup(PerceptualHash::Algorithm::Dct, Settings::defaultThreshold,
+                 QString::fromLatin1(Settings::defaultPrefix), 0, nullptr)
+{
+}
+
+ImageGroup::ImageGroup(PerceptualHash::Algorithm algorithm, int threshold, QStringView prefix,
+                       int pos, QObject *parent)
+    : AbstractNeedFileInfo{pos, parent},
+      m_algorithm{algorithm},
+      m_threshold{usableThreshold(threshold)},
+      m_prefix{prefix.toString()}
+{
+}
+
+void ImageGroup::build(QString &result)
+{
+    emit needFileInfo(this);
+
+    // clustered by ThreadCreateNewNames before any name is built
+    const int group = m_fileInfo->imageGroup(m_algorithm, m_threshold);
+
+    if (group == 0)
+        return;
+
+    Format::DecimalBuffer groupBuffer;
+    Format::DecimalBuffer memberBuffer;
+
+    const int member = m_fileInfo->imageGroupMember(m_algorithm, m_threshold);
+    const QStringView groupNumber = Format::decimal(group, 3, groupBuffer);
+    const QStringView memberNumber = Format::decimal(member, 2, memberBuffer);
+    const qsizetype pos = actualInsertPosition(result.size());
+
+    result.insert(pos, memberNumber);
+    result.insert(pos, u'_');
+    result.insert(pos, groupNumber);
+    result.insert(pos, m_prefix);
+}
+
+qsizetype ImageGroup::lengthHint() const
+{
+    return m_prefix.size() + 6;
+}
+
+QString ImageGroup::toHtmlString() const
+{
+    const QString text = tr("<b>Similar Image Group</b> %1 &le; %2")
+                         .arg(PerceptualHash::algorithmName(m_algorithm)).arg(m_threshold);
+
+    if (isLeftMost())
+        return Html::leftAligned(QStringLiteral("&lt;&lt; %1").arg(text));
+
+    if (isRightMost())
+        return Html::rightAligned(QStringLiteral("%1 &gt;&gt;").arg(text));
+
+    return Html::leftAligned(QStringLiteral("__%1__ %2").arg(insertPosition()).arg(text));
+}
+
+AbstractWidget *ImageGroup::settingsWidget()
+{
+    auto widget = new WidgetImageGroupSetting(m_algorithm, m_threshold, m_prefix, insertPosition());
+
+    connect(widget, &AbstractWidget::accepted, this, [&, this]() {
+        auto settingsWidget = qobject_cast<WidgetImageGroupSetting *>(sender());
+
+        m_algorithm = settingsWidget->algorithm();
+        m_threshold = usableThreshold(settingsWidget->threshold());
+        m_prefix = settingsWidget->prefix();
+        setInsertPosition(settingsWidget->insertPosition());
+    });
+
+    return widget;
+}
+
+void ImageGroup::loadSettings(QSettings *qSet)
+{
+    qSet->beginGroup(Settings::groupName);
+
+    const int value = qSet->value(Settings::keyAlgorithm,
+                                  int(PerceptualHash::Algorithm::Dct)).toInt();
+
+    m_algorithm = isUsable(PerceptualHash::Algorithm(value)) ? PerceptualHash::Algorithm(value)
+                                                            : PerceptualHash::Algorithm::Dct;
+
+    bool isNumber = false;
+    const int threshold = qSet->value(Settings::keyThreshold, Settings::defaultThreshold)
+                          .toInt(&isNumber);
+
+    m_threshold = (isNumber && threshold >= 0) ? usableThreshold(threshold)
+                                               : Settings::defaultThreshold;
+    m_prefix = qSet->value(Settings::keyPrefix, QString::fromLatin1(Settings::defaultPrefix)).toString();
+    AbstractInsertString::loadSettings(qSet);
+
+    qSet->endGroup();
+}
+
+void ImageGroup::saveSettings(QSettings *qSet) const
+{
+    qSet->beginGroup(Settings::groupName);
+
+    qSet->setValue(Settings::keyAlgorithm, int(m_algorithm));
+    qSet->setValue(Settings::keyThreshold, m_threshold);
+    qSet->setValue(Settings::keyPrefix, m_prefix);
+    AbstractInsertString::saveSettings(qSet);
+
+    qSet->endGroup();
+}
+
+PerceptualHash::Algorithm ImageGroup::algorithm() const
+{
+    return m_algorithm;
+}
+
+int ImageGroup::threshold() const
+{
+    return m_threshold;
+}
+
+} // OnFile
+} // StringBuilder
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "abstractneedfileinfo.h"
+#include "imagehash/imagehashalgorithm.h"
+
+namespace StringBuilder {
+namespace OnFile {
+
+// Inserts the prefix, the cluster number and the number within the cluster, e.g.
+// "group042_03", to images that look like another image of the list.
+class ImageGroup : public AbstractNeedFileInfo
+{
+    Q_OBJECT
+public:
+    ImageGroup();
+    ImageGroup(PerceptualHash::Algorithm algorithm, int threshold, QStringView prefix, int pos,
+               QObject *parent = nullptr);
+
+    constexpr BuilderType builderType() const override
+    {
+        return BuilderType::ImageGroup;
+    }
+
+    void build(QString &result) override;
+    qsizetype lengthHint() const override;
+    QString toHtmlString() const override;
+    AbstractWidget *settingsWidget() override;
+
+    void loadSettings(QSettings *qSet) override;
+    void saveSettings(QSettings *qSet) const override;
+
+    PerceptualHash::Algorithm algorithm() const;
+    int threshold() const; // the max Hamming distance of similar images
+
+private:
+    PerceptualHash::Algorithm m_algorithm;
+    int m_threshold;
+    QString m_prefix;
+};
+
+} // OnFile
+} // StringBuilder
@@ -22,51 +22,88 @@
 #include "imagehash/imagehashcalculator.h"
 #include "stringbuilder/widgets/widgetimagehashsetting.h"
 #include "utilityshtml.h"
+#include "utilitysformat.h"
 
 #include <QSettings>
+#include <QtEndian>
 
 namespace StringBuilder {
 namespace OnFile {
 
 namespace Settings {
 constexpr char groupName[] = "ImageHash";
+constexpr char keyAlgorithm[] = "Algorithm";
 } // Settings
 
+ImageHash::ImageHash()
+    : ImageHash(PerceptualHash::Algorithm::Difference, 0, nullptr)
+{
+}
+
+ImageHash::ImageHash(PerceptualHash::Algorithm algorithm, int pos, QObject *parent)
+    : AbstractNeedFileInfo{pos, parent},
+      m_algorithm{algorithm}
+{
+}
+
 void ImageHash::build(QString &result)
 {
     emit needFileInfo(this);
 
-    QString imageHashString = m_fileInfo->imageHash();
+    std::optional<quint64> hash = m_fileInfo->imageHash(m_algorithm);
 
-    if (imageHashString.isEmpty()) {
+    if (!hash.has_value()) {
         ImageHashCalculator imageHash(m_fileInfo->fullPath());
 
-        imageHashString = imageHash.resultString();
+        hash = imageHash.result(m_algorithm);
+
+        if (!hash.has_value())
+            return;
 
-        m_fileInfo->setImageHash(imageHashString);
+        m_fileInfo->setImageHash(m_algorithm, *hash);
     }
 
-    result.insert(actualInsertPosition(result.size()), imageHashString);
+    char bytes[sizeof(quint64)];
+    Format::HexBuffer buffer;
+
+    qToBigEndian(*hash, bytes);
+
+    result.insert(actualInsertPosition(result.size()),
+                  Format::hex(QByteArrayView(bytes, sizeof(bytes)), buffer));
+}
+
+qsizetype ImageHash::lengthHint() const
+{
+    return 16; // 64 bit hash in hex
+}
+
+PerceptualHash::Algorithm ImageHash::algorithm() const
+{
+    return m_algorithm;
 }
 
 QString ImageHash::toHtmlString() const
 {
+    const QString algorithmName = PerceptualHash::algorithmName(m_algorithm);
+
     if (isLeftMost())
-        return Html::leftAligned(tr("&lt;&lt; <b>Image Hash</b>"));
+        return Html::leftAligned(tr("&lt;&lt; <b>Image Hash</b> %1").arg(algorithmName));
 
     if (isRightMost())
-        return Html::rightAligned(tr("<b>Image Hash</b> &gt;&gt;"));
+        return Html::rightAligned(tr("<b>Image Hash</b> %1 &gt;&gt;").arg(algorithmName));
 
-    return Html::leftAligned(tr("__%1__ <b>Image Hash</b>").arg(insertPosition()));
+    return Html::leftAligned(
+                tr("__%1__ <b>Image Hash</b> %2").arg(insertPosition()).arg(algorithmName));
 }
 
 AbstractWidget *ImageHash::settingsWidget()
 {
-    auto widget = new WidgetImageHashSetting(insertPosition());
+    auto widget = new WidgetImageHashSetting(m_algorithm, insertPosition());
 
     connect(widget, &AbstractWidget::accepted, this, [&, this]() {
         auto settingsWidget = qobject_cast<WidgetImageHashSetting *>(sender());
 
+        m_algorithm = settingsWidget->algorithm();
         setInsertPosition(settingsWidget->insertPosition());
     });
 
@@ -77,6 +114,10 @@ void ImageHash::loadSettings(QSettings *qSet)
 {
     qSet->beginGroup(Settings::groupName);
 
+    const int value = qSet->value(Settings::keyAlgorithm,
+                                  int(PerceptualHash::Algorithm::Difference)).toInt();
+
+    m_algorithm = PerceptualHash::Algorithm(value);
     AbstractInsertString::loadSettings(qSet);
 
     qSet->endGroup();
@@ -86,6 +127,7 @@ void ImageHash::saveSettings(QSettings *qSet) const
 {
     qSet->beginGroup(Settings::groupName);
 
+    qSet->setValue(Settings::keyAlgorithm, int(m_algorithm));
     AbstractInsertString::saveSettings(qSet);
 
     qSet->endGroup();
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "abstractneedfileinfo.h"
+#include "imagehash/imagehashalgorithm.h"
 
 namespace StringBuilder {
 namespace OnFile {
@@ -28,7 +29,8 @@ class ImageHash : public AbstractNeedFileInfo
 {
     Q_OBJECT
 public:
-    using AbstractNeedFileInfo::AbstractNeedFileInfo;
+    ImageHash();
+    ImageHash(PerceptualHash::Algorithm algorithm, int pos, QObject *parent = nullptr);
 
     constexpr BuilderType builderType() const override
     {
@@ -36,11 +38,17 @@ public:
     }
 
     void build(QString &result) override;
+    qsizetype lengthHint() const override;
     QString toHtmlString() const override;
     AbstractWidget *settingsWidget() override;
 
     void loadSettings(QSettings *qSet) override;
     void saveSettings(QSettings *qSet) const override;
+
+    PerceptualHash::Algorithm algorithm() const;
+
+private:
+    PerceptualHash::Algorithm m_algorithm;
 };
 
 } // OnFile
@@ -35,10 +35,17 @@ void OriginalName::build(QString &result)
 {
     emit needFileInfo(this);
 
-    QString name = m_fileInfo->isDir() ? m_fileInfo->fileName()
-                                       : m_fileInfo->completeBaseName();
+    if (m_fileInfo->isDir()) {
+        result.insert(actualInsertPosition(result.size()), m_fileInfo->fileName());
+        return;
+    }
 
-    result.insert(actualInsertPosition(result.size()), name);
+    result.insert(actualInsertPosition(result.size()), m_fileInfo->completeBaseName());
+}
+
+qsizetype OriginalName::lengthHint() const
+{
+    return 255; // NAME_MAX of most file systems
 }
 
 QString OriginalName::toHtmlString() const
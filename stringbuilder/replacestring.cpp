@@ -21,7 +21,6 @@
 #include "utilityshtml.h"
 #include "widgets/widgetreplacesetting.h"
 
-#include <QRegularExpression>
 #include <QSettings>
 
 namespace StringBuilder {
@@ -47,22 +46,43 @@ ReplaceString::ReplaceString(QStringView before, QStringView after,
       m_isUseRegExp{isUseRegExp},
       m_isCaseSensitive{isCaseSensitive}
 {
+    updateMatcher();
 }
 
 void ReplaceString::build(QString &result)
 {
-    if (!m_isUseRegExp) {
-        Qt::CaseSensitivity caseSensitivity = m_isCaseSensitive ? Qt::CaseSensitive
-                                                                : Qt::CaseInsensitive;
-        result.replace(m_before, m_after, caseSensitivity);
+    if (m_isUseRegExp) {
+        result.replace(m_regExp, m_after);
         return;
     }
 
-    QRegularExpression::PatternOptions options
-            = m_isCaseSensitive ? QRegularExpression::NoPatternOption
-                                : QRegularExpression::CaseInsensitiveOption;
+    if (m_before.isEmpty()) {
+        result.replace(m_before, m_after, m_matcher.caseSensitivity());
+        return;
+    }
+
+    qsizetype index = m_matcher.indexIn(result);
+
+    if (index == -1)
+        return;
+
+    static thread_local QString replaced; // swapped with result to keep both capacities.
+    qsizetype from = 0;
+
+    replaced.resize(0);
+    replaced.reserve(result.size() + m_after.size());
+
+    do {
+        replaced.append(QStringView{result}.sliced(from, index - from));
+        replaced.append(m_after);
+
+        from = index + m_before.size();
+        index = m_matcher.indexIn(result, from);
+    } while (index != -1);
+
+    replaced.append(QStringView{result}.sliced(from));
 
-    result.replace(QRegularExpression{m_before, options}, m_after);
+    result.swap(replaced);
 }
 
 QString ReplaceString::toHtmlString() const
@@ -86,6 +106,8 @@ AbstractWidget *ReplaceString::settingsWidget()
         m_after = settingsWidget->replaceString();
         m_isUseRegExp = settingsWidget->isUseRegExp();
         m_isCaseSensitive = settingsWidget->isCaseSensitive();
+
+        updateMatcher();
     });
 
     return widget;
@@ -101,6 +123,8 @@ void ReplaceString::loadSettings(QSettings *qSet)
     m_isCaseSensitive = qSet->value(Settings::keyIsCaseSensitive, true).toBool();
 
     qSet->endGroup();
+
+    updateMatcher();
 }
 
 void ReplaceString::saveSettings(QSettings *qSet) const
@@ -115,5 +139,23 @@ void ReplaceString::saveSettings(QSettings *qSet) const
     qSet->endGroup();
 }
 
+void ReplaceString::updateMatcher()
+{
+    m_matcher.setPattern(m_before);
+    m_matcher.setCaseSensitivity(m_isCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+
+    if (!m_isUseRegExp) {
+        m_regExp = QRegularExpression{};
+        return;
+    }
+
+    QRegularExpression::PatternOptions options
+            = m_isCaseSensitive ? QRegularExpression::NoPatternOption
+                                : QRegularExpression::CaseInsensitiveOption;
+
+    m_regExp = QRegularExpression{m_before, options};
+    m_regExp.optimize(); // compile and JIT now, not on the first file.
+}
+
 } // StringBuilder
 
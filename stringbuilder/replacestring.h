@@ -21,6 +21,9 @@
 
 #include "abstractstringbuilder.h"
 
+#include <QRegularExpression>
+#include <QStringMatcher>
+
 namespace StringBuilder {
 
 class ReplaceString : public AbstractStringBuilder
@@ -44,10 +47,16 @@ public:
     void saveSettings(QSettings *qSet) const override;
 
 private:
+    void updateMatcher();
+
     QString m_before;
     QString m_after;
     bool m_isUseRegExp;
     bool m_isCaseSensitive;
+
+    // compiled once per settings change, reused for every file.
+    QRegularExpression m_regExp;
+    QStringMatcher m_matcher;
 };
 
 } // StringBuilder
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "replacetable.h"
+#include "utilityshtml.h"
+#include "widgets/widgetreplacetablesetting.h"
+
+#include "filenamevalidator.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QTextStream>
+
+namespace StringBuilder {
+
+namespace Settings {
+constexpr char groupName[] = "ReplaceTable";
+constexpr char keyTableFilePath[] = "TableFilePath";
+constexpr char keyIsCaseSensitive[] = "CaseSensitive";
+} // Settings
+
+namespace {
+
+// "a","b" -> {a, b}. Quotes are only needed when a field contains the separator.
+QStringList splitRow(QStringView line, QChar separator)
+{
+    QStringList fields;
+    QString field;
+    bool isQuoted = false;
+
+    for (qsizetype i = 0, size = line.size(); i < size; ++i) {
+        const QChar c = line.at(i);
+
+        if (isQuoted) {
+            if (c != '"')
+                field += c;
+            else if (i + 1 < size && line.at(i + 1) == '"')
+                field += line.at(++i);
+            else
+                isQuoted = false;
+        } else if (c == '"') {
+            isQuoted = true;
+        } else if (c == separator) {
+            fields << field;
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+
+    fields << field;
+
+    return fields;
+}
+
+} // anonymous
+
+ReplaceTable::ReplaceTable()
+    : ReplaceTable(QString{}, true, nullptr)
+{
+}
+
+ReplaceTable::ReplaceTable(QStringView tableFilePath, bool isCaseSensitive, QObject *parent)
+    : AbstractStringBuilder{parent},
+      m_tableFilePath{tableFilePath.toString()},
+      m_isCaseSensitive{isCaseSensitive}
+{
+    updateAutomaton();
+}
+
+void ReplaceTable::build(QString &result)
+{
+    m_automaton.replace(result);
+}
+
+QString ReplaceTable::toHtmlString() const
+{
+    const QString caseSensitive(m_isCaseSensitive ? tr("CaseSensitive") : tr("CaseInsensitive"));
+
+    if (m_tableFilePath.isEmpty())
+        return Html::centerAligned(tr("<b>Replace Table</b> [%1]").arg(caseSensitive));
+
+    QString text = tr("<b>Replace Table</b> <i>%1</i> [%2 entries][%3]")
+                   .arg(QFileInfo(m_tableFilePath).fileName())
+                   .arg(m_automaton.keywordCount())
+                   .arg(caseSensitive);
+
+    if (m_rejectedRowCount > 0)
+        text += tr("[%1 rows with invalid characters skipped]").arg(m_rejectedRowCount);
+
+    return Html::centerAligned(text);
+}
+
+AbstractWidget *ReplaceTable::settingsWidget()
+{
+    auto widget = new WidgetReplaceTableSetting(m_tableFilePath, m_isCaseSensitive);
+
+    connect(widget, &AbstractWidget::accepted, this, [this]() {
+        auto settingsWidget = qobject_cast<WidgetReplaceTableSetting *>(sender());
+
+        m_tableFilePath = settingsWidget->tableFilePath();
+        m_isCaseSensitive = settingsWidget->isCaseSensitive();
+
+        updateAutomaton();
+    });
+
+    return widget;
+}
+
+void ReplaceTable::loadSettings(QSettings *qSet)
+{
+    qSet->beginGroup(Settings::groupName);
+
+    m_tableFilePath = qSet->value(Settings::keyTableFilePath, QString{}).toString();
+    m_isCaseSensitive = qSet->value(Settings::keyIsCaseSensitive, true).toBool();
+
+    qSet->endGroup();
+
+    updateAutomaton();
+}
+
+void ReplaceTable::saveSettings(QSettings *qSet) const
+{
+    qSet->beginGroup(Settings::groupName);
+
+    qSet->setValue(Settings::keyTableFilePath, m_tableFilePath);
+    qSet->setValue(Settings::keyIsCaseSensitive, m_isCaseSensitive);
+
+    qSet->endGroup();
+}
+
+// One "find<separator>replace" pair per line. TSV if the file is *.tsv or *.tab, CSV otherwise.
+// Rows whose replacement can not be in a file name are skipped and counted in rejectedRowCount.
+QList<AhoCorasick::Replacement> ReplaceTable::readTable(QStringView tableFilePath,
+                                                        qsizetype *rejectedRowCount)
+{
+    QList<AhoCorasick::Replacement> table;
+
+    if (rejectedRowCount != nullptr)
+        *rejectedRowCount = 0;
+
+    if (tableFilePath.isEmpty())
+        return table;
+
+    QFile file(tableFilePath.toString());
+
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+        return table;
+
+    const QString suffix = QFileInfo(file).suffix().toLower();
+    const QChar separator = (suffix == QStringLiteral("tsv") || suffix == QStringLiteral("tab"))
+                            ? QChar('\t') : QChar(',');
+
+    const FileNameVlidator validator;
+    QTextStream stream(&file);
+    QString line;
+
+    while (stream.readLineInto(&line)) {
+        if (line.isEmpty())
+            continue;
+
+        QStringList fields = splitRow(line, separator);
+
+        if (fields.first().isEmpty())
+            continue;
+
+        QString replacement = fields.value(1);
+        int pos = 0;
+
+        if (validator.validate(replacement, pos) == QValidator::Invalid) {
+            if (rejectedRowCount != nullptr)
+                ++*rejectedRowCount;
+
+            continue;
+        }
+
+        table.append({fields.first(), replacement});
+    }
+
+    return table;
+}
+
+void ReplaceTable::updateAutomaton()
+{
+    m_automaton.build(readTable(m_tableFilePath, &m_rejectedRowCount),
+                      m_isCaseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+}
+
+} // StringBuilder
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "abstractstringbuilder.h"
+#include "ahocorasick.h"
+
+namespace StringBuilder {
+
+class ReplaceTable : public AbstractStringBuilder
+{
+    Q_OBJECT
+public:
+    ReplaceTable();
+    ReplaceTable(QStringView tableFilePath, bool isCaseSensitive, QObject *parent = nullptr);
+
+    constexpr BuilderType builderType() const override
+    {
+        return BuilderType::ReplaceTable;
+    }
+
+    void build(QString &result) override;
+    QString toHtmlString() const override;
+    AbstractWidget *settingsWidget() override;
+
+    void loadSettings(QSettings *qSet) override;
+    void saveSettings(QSettings *qSet) const override;
+
+    static QList<AhoCorasick::Replacement> readTable(QStringView tableFilePath,
+                                                     qsizetype *rejectedRowCount = nullptr);
+
+private:
+    void updateAutomaton();
+
+    QString m_tableFilePath;
+    bool m_isCaseSensitive;
+    qsizetype m_rejectedRowCount = 0;
+
+    AhoCorasick m_automaton;
+};
+
+} // StringBuilder
@@ -22,7 +22,11 @@
 #include "insertstring.h"
 #include "number.h"
 #include "replacestring.h"
+#include "replacetable.h"
 #include "onfile/cryptographichash.h"
+#include "onfile/duplicategroup.h"
+#include "onfile/imagedimensions.h"
+#include "onfile/imagegroup.h"
 #include "onfile/imagehash.h"
 #include "onfile/originalname.h"
 
@@ -50,6 +54,18 @@ SharedStringBuilder BuilderFactory::createBuilder(BuilderType builderType)
     if (builderType == BuilderType::ImageHash)
         return QSharedPointer<OnFile::ImageHash>::create();
 
+    if (builderType == BuilderType::ReplaceTable)
+        return QSharedPointer<ReplaceTable>::create();
+
+    if (builderType == BuilderType::DuplicateGroup)
+        return QSharedPointer<OnFile::DuplicateGroup>::create();
+
+    if (builderType == BuilderType::ImageGroup)
+        return QSharedPointer<OnFile::ImageGroup>::create();
+
+    if (builderType == BuilderType::ImageDimensions)
+        return QSharedPointer<OnFile::ImageDimensions>::create();
+
     Q_ASSERT(false);
 
     return nullptr;
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "widgetduplicategroupsetting.h"
+#include "ui_widgetduplicategroupsetting.h"
+
+#include "filenamevalidator.h"
+#include "stringbuilder/onfile/duplicategroup.h"
+
+namespace StringBuilder {
+
+WidgetDuplicateGroupSetting::WidgetDuplicateGroupSetting(QWidget *parent)
+    : WidgetDuplicateGroupSetting(u"_dup", 0, parent) {}
+
+WidgetDuplicateGroupSetting::WidgetDuplicateGroupSetting(QStringView prefix, int insertPos,
+                                                         QWidget *parent)
+    : AbstractWidget{parent},
+      ui{new Ui::WidgetDuplicateGroupSetting}
+{
+    ui->setupUi(this);
+
+    setWindowTitle(tr("Duplicate Group"));
+
+    ui->lineEditPrefix->setValidator(new FileNameVlidator(this));
+    ui->lineEditPrefix->setText(prefix.toString());
+    ui->widgetPositionFixer->setValue(insertPos);
+
+    connect(ui->lineEditPrefix, &QLineEdit::textChanged, this, &AbstractWidget::changeStarted);
+
+    connect(ui->widgetPositionFixer, &WidgetPositionFixer::changeStarted,
+            this, &AbstractWidget::changeStarted);
+}
+
+WidgetDuplicateGroupSetting::~WidgetDuplicateGroupSetting()
+{
+    delete ui;
+}
+
+QSharedPointer<AbstractStringBuilder> WidgetDuplicateGroupSetting::stringBuilder() const
+{
+    return QSharedPointer<OnFile::DuplicateGroup>::create(ui->widgetPositionFixer->value(), prefix());
+}
+
+void WidgetDuplicateGroupSetting::setFocusToFirstWidget()
+{
+    ui->lineEditPrefix->setFocus();
+}
+
+QString WidgetDuplicateGroupSetting::prefix() const
+{
+    return ui->lineEditPrefix->text();
+}
+
+int WidgetDuplicateGroupSetting::insertPosition() const
+{
+    return ui->widgetPositionFixer->value();
+}
+
+} // StringBuilder
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "abstractstringbuilderwidget.h"
+
+namespace StringBuilder {
+
+namespace Ui {
+class WidgetDuplicateGroupSetting;
+}
+
+class WidgetDuplicateGroupSetting : public AbstractWidget
+{
+    Q_OBJECT
+public:
+    explicit WidgetDuplicateGroupSetting(QWidget *parent = nullptr);
+    WidgetDuplicateGroupSetting(QStringView prefix, int insertPos, QWidget *parent = nullptr);
+    ~WidgetDuplicateGroupSetting() override;
+
+    // StringBuilder::AbstractWidget interface
+    QSharedPointer<AbstractStringBuilder> stringBuilder() const override;
+    void setFocusToFirstWidget() override;
+
+    QString prefix() const;
+    int insertPosition() const;
+
+private:
+    Ui::WidgetDuplicateGroupSetting *ui;
+};
+
+} // StringBuilder
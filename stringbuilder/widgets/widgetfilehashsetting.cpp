@@ -25,10 +25,10 @@
 namespace StringBuilder {
 
 WidgetFileHashSetting::WidgetFileHashSetting(QWidget *parent)
-    : WidgetFileHashSetting(QCryptographicHash::Algorithm::Md5, 0, parent) {}
+    : WidgetFileHashSetting(FileHash::Algorithm::Md5, 0, 0, parent) {}
 
-WidgetFileHashSetting::WidgetFileHashSetting(QCryptographicHash::Algorithm algorithm, int insertPos,
-                                             QWidget *parent)
+WidgetFileHashSetting::WidgetFileHashSetting(FileHash::Algorithm algorithm, int sampleCount,
+                                             int insertPos, QWidget *parent)
     : AbstractWidget(parent),
       ui(new Ui::WidgetFileHashSetting)
 {
@@ -37,19 +37,24 @@ WidgetFileHashSetting::WidgetFileHashSetting(QCryptographicHash::Algorithm algor
     setWindowTitle(tr("File Hash"));
 
     ui->widgetPositionFixer->setValue(insertPos);
+    ui->checkBoxSampled->setChecked(sampleCount > 0);
 
-    using Algorithm = QCryptographicHash::Algorithm;
+    if (sampleCount > 0)
+        ui->spinBoxSampleCount->setValue(sampleCount);
 
-    ui->comboBoxHashType->addItem(QStringLiteral("SHA2-224"), Algorithm::Sha224);
-    ui->comboBoxHashType->addItem(QStringLiteral("SHA2-256"), Algorithm::Sha256);
-//    ui->comboBoxHashType->addItem(QStringLiteral("SHA2-512"), Algorithm::Sha512); // too long for filename
-    ui->comboBoxHashType->addItem(QStringLiteral("SHA3-224"), Algorithm::Sha3_224);
-    ui->comboBoxHashType->addItem(QStringLiteral("SHA3-256"), Algorithm::Sha3_256);
-//    ui->comboBoxHashType->addItem(QStringLiteral("SHA3-512"), Algorithm::Sha3_512);
-    ui->comboBoxHashType->addItem(QStringLiteral("MD5"), Algorithm::Md5);
-    ui->comboBoxHashType->addItem(QStringLiteral("SHA1"), Algorithm::Sha1);
+    using Algorithm = FileHash::Algorithm;
 
-    int index = ui->comboBoxHashType->findData(algorithm);
+    // SHA2-512 and SHA3-512 are too long for filename
+    const QList<Algorithm> algorithms = {
+        Algorithm::Sha224, Algorithm::Sha256, Algorithm::Sha3_224, Algorithm::Sha3_256,
+        Algorithm::Md5, Algorithm::Sha1,
+        Algorithm::Crc32c, Algorithm::XxHash64, Algorithm::Blake3,
+    };
+
+    for (Algorithm item : algorithms)
+        ui->comboBoxHashType->addItem(FileHash::algorithmName(item), int(item));
+
+    int index = ui->comboBoxHashType->findData(int(algorithm));
 
     if (index != -1)
         ui->comboBoxHashType->setCurrentIndex(index);
@@ -57,6 +62,11 @@ WidgetFileHashSetting::WidgetFileHashSetting(QCryptographicHash::Algorithm algor
     connect(ui->comboBoxHashType, &QComboBox::currentIndexChanged,
             this, &AbstractWidget::changeStarted);
 
+    connect(ui->checkBoxSampled, &QCheckBox::toggled, this, &AbstractWidget::changeStarted);
+
+    connect(ui->spinBoxSampleCount, &QSpinBox::valueChanged,
+            this, &AbstractWidget::changeStarted);
+
     connect(ui->widgetPositionFixer, &WidgetPositionFixer::changeStarted,
             this, &AbstractWidget::changeStarted);
 }
@@ -68,12 +78,8 @@ WidgetFileHashSetting::~WidgetFileHashSetting()
 
 QSharedPointer<AbstractStringBuilder> WidgetFileHashSetting::stringBuilder() const
 {
-    using Algorithm = QCryptographicHash::Algorithm;
-
-    auto algorithm = Algorithm(ui->comboBoxHashType->currentData().toInt());
-
     return QSharedPointer<OnFile::CryptographicHash>::create(
-                algorithm, ui->widgetPositionFixer->value());
+                algorithm(), sampleCount(), ui->widgetPositionFixer->value());
 }
 
 void WidgetFileHashSetting::setFocusToFirstWidget()
@@ -81,9 +87,14 @@ void WidgetFileHashSetting::setFocusToFirstWidget()
     ui->comboBoxHashType->setFocus();
 }
 
-QCryptographicHash::Algorithm WidgetFileHashSetting::algorithm() const
+FileHash::Algorithm WidgetFileHashSetting::algorithm() const
+{
+    return FileHash::Algorithm(ui->comboBoxHashType->currentData().toInt());
+}
+
+int WidgetFileHashSetting::sampleCount() const
 {
-    return QCryptographicHash::Algorithm(ui->comboBoxHashType->currentData().toInt());
+    return ui->checkBoxSampled->isChecked() ? ui->spinBoxSampleCount->value() : 0;
 }
 
 int WidgetFileHashSetting::insertPosition() const
@@ -20,8 +20,7 @@
 #pragma once
 
 #include "abstractstringbuilderwidget.h"
-
-#include <QCryptographicHash>
+#include "filehash/filehashalgorithm.h"
 
 namespace StringBuilder {
 
@@ -34,7 +33,7 @@ class WidgetFileHashSetting : public AbstractWidget
     Q_OBJECT
 public:
     explicit WidgetFileHashSetting(QWidget *parent = nullptr);
-    WidgetFileHashSetting(QCryptographicHash::Algorithm algorithm, int insertPos,
+    WidgetFileHashSetting(FileHash::Algorithm algorithm, int sampleCount, int insertPos,
                           QWidget *parent = nullptr);
     ~WidgetFileHashSetting() override;
 
@@ -42,7 +41,8 @@ public:
     QSharedPointer<AbstractStringBuilder> stringBuilder() const override;
     void setFocusToFirstWidget() override;
 
-    QCryptographicHash::Algorithm algorithm() const;
+    FileHash::Algorithm algorithm() const;
+    int sampleCount() const; // 0 means the whole file
     int insertPosition() const;
 
 private:
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "widgetimagedimensionssetting.h"
+#include "ui_widgetimagedimensionssetting.h"
+
+#include "filenamevalidator.h"
+#include "stringbuilder/onfile/imagedimensions.h"
+
+namespace StringBuilder {
+
+WidgetImageDimensionsSetting::WidgetImageDimensionsSetting(QWidget *parent)
+    : WidgetImageDimensionsSetting(u"_%wx%h", 0, parent) {}
+
+WidgetImageDimensionsSetting::WidgetImageDimensionsSetting(QStringView textTemplate, int insertPos,
+                                                           QWidget *parent)
+    : AbstractWidget{parent},
+      ui{new Ui::WidgetImageDimensionsSetting}
+{
+    ui->setupUi(this);
+
+    setWindowTitle(tr("Image Dimensions"));
+
+    ui->lineEditTemplate->setValidator(new FileNameVlidator(this));
+    ui->lineEditTemplate->setText(textTemplate.toString());
+    ui->widgetPositionFixer->setValue(insertPos);
+
+    connect(ui->lineEditTemplate, &QLineEdit::textChanged, this, &AbstractWidget::changeStarted);
+
+    connect(ui->widgetPositionFixer, &WidgetPositionFixer::changeStarted,
+            this, &AbstractWidget::changeStarted);
+}
+
+WidgetImageDimensionsSetting::~WidgetImageDimensionsSetting()
+{
+    delete ui;
+}
+
+QSharedPointer<AbstractStringBuilder> WidgetImageDimensionsSetting::stringBuilder() const
+{
+    return QSharedPointer<OnFile::ImageDimensions>::create(ui->widgetPositionFixer->value(),
+                                                          textTemplate());
+}
+
+void WidgetImageDimensionsSetting::setFocusToFirstWidget()
+{
+    ui->lineEditTemplate->setFocus();
+}
+
+QString WidgetImageDimensionsSetting::textTemplate() const
+{
+    return ui->lineEditTemplate->text();
+}
+
+int WidgetImageDimensionsSetting::insertPosition() const
+{
+    return ui->widgetPositionFixer->value();
+}
+
+} // StringBuilder
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "widgetimagegroupsetting.h"
+#include "ui_widgetimagegroupsetting.h"
+
+#include "filenamevalidator.h"
+#include "imagehash/imageclusterfinder.h"
+#include "stringbuilder/onfile/imagegroup.h"
+
+namespace StringBuilder {
+
+WidgetImageGroupSetting::WidgetImageGroupSetting(QWidget *parent)
+    : WidgetImageGroupSetting(PerceptualHash::Algorithm::Dct, 10, u"group", 0, parent)
+{
+}
+
+WidgetImageGroupSetting::WidgetImageGroupSetting(PerceptualHash::Algorithm algorithm,
+                                                 int threshold, QStringView prefix,
+                                                 int insertPos, QWidget *parent)
+    : AbstractWidget{parent},
+      ui{new Ui::WidgetImageGroupSetting}
+{
+    ui->setupUi(this);
+
+    setWindowTitle(tr("Similar Image Group"));
+
+    using Algorithm = PerceptualHash::Algorithm;
+
+    const QList<Algorithm> algorithms = {
+        Algorithm::Dct, Algorithm::Difference, Algorithm::Average, Algorithm::Wavelet,
+    };
+
+    for (Algorithm item : algorithms)
+        ui->comboBoxAlgorithm->addItem(PerceptualHash::algorithmName(item), int(item));
+
+    int index = ui->comboBoxAlgorithm->findData(int(algorithm));
+
+    if (index != -1)
+        ui->comboBoxAlgorithm->setCurrentIndex(index);
+
+    ui->spinBoxThreshold->setMaximum(ImageClusterFinder::maxThreshold);
+    ui->spinBoxThreshold->setValue(threshold);
+    ui->lineEditPrefix->setValidator(new FileNameVlidator(this));
+    ui->lineEditPrefix->setText(prefix.toString());
+    ui->widgetPositionFixer->setValue(insertPos);
+
+    connect(ui->comboBoxAlgorithm, &QComboBox::currentIndexChanged,
+            this, &AbstractWidget::changeStarted);
+
+    connect(ui->spinBoxThreshold, &QSpinBox::valueChanged, this, &AbstractWidget::changeStarted);
+    connect(ui->lineEditPrefix, &QLineEdit::textChanged, this, &AbstractWidget::changeStarted);
+
+    connect(ui->widgetPositionFixer, &WidgetPositionFixer::changeStarted,
+            this, &AbstractWidget::changeStarted);
+}
+
+WidgetImageGroupSetting::~WidgetImageGroupSetting()
+{
+    delete ui;
+}
+
+QSharedPointer<AbstractStringBuilder> WidgetImageGroupSetting::stringBuilder() const
+{
+    return QSharedPointer<OnFile::ImageGroup>::create(
+                algorithm(), threshold(), prefix(), insertPosition());
+}
+
+void WidgetImageGroupSetting::setFocusToFirstWidget()
+{
+    ui->comboBoxAlgorithm->setFocus();
+}
+
+PerceptualHash::Algorithm WidgetImageGroupSetting::algorithm() const
+{
+    return PerceptualHash::Algorithm(ui->comboBoxAlgorithm->currentData().toInt());
+}
+
+int WidgetImageGroupSetting::threshold() const
+{
+    return ui->spinBoxThreshold->value();
+}
+
+QString WidgetImageGroupSetting::prefix() const
+{
+    return ui->lineEditPrefix->text();
+}
+
+int WidgetImageGroupSetting::insertPosition() const
+{
+    return ui->widgetPositionFixer->value();
+}
+
+} // StringBuilder
@@ -16,29 +16,79 @@
  * You should have received a copy of the GNU General Public License
  * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
  */
-
 #include "widgetimagehashsetting.h"
+#include "ui_widgetimagehashsetting.h"
 
 #include "stringbuilder/onfile/imagehash.h"
 
-#include <QSettings>
-
 namespace StringBuilder {
 
 WidgetImageHashSetting::WidgetImageHashSetting(QWidget *parent)
-    : WidgetImageHashSetting(0, parent)
+    : WidgetImageHashSetting(PerceptualHash::Algorithm::Difference, 0, parent)
 {
 }
 
-WidgetImageHashSetting::WidgetImageHashSetting(int insertPos, QWidget *parent)
-    : WidgetOnlyPositionFixer(insertPos, parent)
+WidgetImageHashSetting::WidgetImageHashSetting(PerceptualHash::Algorithm algorithm, int insertPos,
+                                               QWidget *parent)
+    : AbstractWidget{parent},
+      ui{new Ui::WidgetImageHashSetting}
 {
-    setTitle(tr("Image Hash"));
+    ui->setupUi(this);
+
+    setWindowTitle(tr("Image Hash"));
+
+    ui->widgetPositionFixer->setValue(insertPos);
+
+    using Algorithm = PerceptualHash::Algorithm;
+
+    const QList<QPair<Algorithm, QString>> algorithms = {
+        {Algorithm::Difference, tr("gradients. fast")},
+        {Algorithm::Average, tr("brightness. fastest, least robust")},
+        {Algorithm::Dct, tr("DCT. robust to scaling and compression")},
+        {Algorithm::Wavelet, tr("Haar wavelet")},
+    };
+
+    for (const auto &[item, description] : algorithms) {
+        ui->comboBoxAlgorithm->addItem(
+                    QStringLiteral("%1 - %2").arg(PerceptualHash::algorithmName(item), description),
+                    int(item));
+    }
+
+    int index = ui->comboBoxAlgorithm->findData(int(algorithm));
+
+    if (index != -1)
+        ui->comboBoxAlgorithm->setCurrentIndex(index);
+
+    connect(ui->comboBoxAlgorithm, &QComboBox::currentIndexChanged,
+            this, &AbstractWidget::changeStarted);
+
+    connect(ui->widgetPositionFixer, &WidgetPositionFixer::changeStarted,
+            this, &AbstractWidget::changeStarted);
+}
+
+WidgetImageHashSetting::~WidgetImageHashSetting()
+{
+    delete ui;
 }
 
 QSharedPointer<AbstractStringBuilder> WidgetImageHashSetting::stringBuilder() const
 {
-    return QSharedPointer<OnFile::ImageHash>::create(insertPosition());
+    return QSharedPointer<OnFile::ImageHash>::create(algorithm(), insertPosition());
+}
+
+void WidgetImageHashSetting::setFocusToFirstWidget()
+{
+    ui->comboBoxAlgorithm->setFocus();
+}
+
+PerceptualHash::Algorithm WidgetImageHashSetting::algorithm() const
+{
+    return PerceptualHash::Algorithm(ui->comboBoxAlgorithm->currentData().toInt());
+}
+
+int WidgetImageHashSetting::insertPosition() const
+{
+    return ui->widgetPositionFixer->value();
 }
 
 } // StringBuilder
@@ -16,21 +16,35 @@
  * You should have received a copy of the GNU General Public License
  * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
  */
-
 #pragma once
 
-#include "widgetonlypositionfixer.h"
+#include "abstractstringbuilderwidget.h"
+#include "imagehash/imagehashalgorithm.h"
 
 namespace StringBuilder {
 
-class WidgetImageHashSetting : public WidgetOnlyPositionFixer
+namespace Ui {
+class WidgetImageHashSetting;
+}
+
+class WidgetImageHashSetting : public AbstractWidget
 {
     Q_OBJECT
 public:
     explicit WidgetImageHashSetting(QWidget *parent = nullptr);
-    WidgetImageHashSetting(int insertPos, QWidget *parent = nullptr);
+    WidgetImageHashSetting(PerceptualHash::Algorithm algorithm, int insertPos,
+                           QWidget *parent = nullptr);
+    ~WidgetImageHashSetting() override;
 
+    // StringBuilder::AbstractWidget interface
     QSharedPointer<AbstractStringBuilder> stringBuilder() const override;
+    void setFocusToFirstWidget() override;
+
+    PerceptualHash::Algorithm algorithm() const;
+    int insertPosition() const;
+
+private:
+    Ui::WidgetImageHashSetting *ui;
 };
 
 } // StringBuilder
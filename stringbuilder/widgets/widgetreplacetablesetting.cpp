@@ -0,0 +1,91 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "widgetreplacetablesetting.h"
+#include "ui_widgetreplacetablesetting.h"
+
+#include "stringbuilder/replacetable.h"
+
+#include <QFileDialog>
+#include <QFileInfo>
+
+namespace StringBuilder {
+
+WidgetReplaceTableSetting::WidgetReplaceTableSetting(QWidget *parent)
+    : WidgetReplaceTableSetting(QString{}, true, parent) {}
+
+WidgetReplaceTableSetting::WidgetReplaceTableSetting(QStringView tableFilePath,
+                                                     bool isCaseSensitive, QWidget *parent)
+    : AbstractWidget{parent},
+      ui{new Ui::WidgetReplaceTableSetting}
+{
+    ui->setupUi(this);
+
+    setWindowTitle(tr("Replace Table"));
+
+    ui->lineEditTableFilePath->setText(tableFilePath.toString());
+    ui->checkBoxCaseSensitive->setChecked(isCaseSensitive);
+
+    connect(ui->toolButtonBrowse, &QToolButton::clicked,
+            this, &WidgetReplaceTableSetting::onToolButtonBrowseClicked);
+
+    connect(ui->checkBoxCaseSensitive, &QCheckBox::clicked,
+            this, &AbstractWidget::changeStarted);
+
+    connect(ui->lineEditTableFilePath, &QLineEdit::textChanged,
+            this, &AbstractWidget::changeStarted);
+}
+
+WidgetReplaceTableSetting::~WidgetReplaceTableSetting()
+{
+    delete ui;
+}
+
+QSharedPointer<AbstractStringBuilder> WidgetReplaceTableSetting::stringBuilder() const
+{
+    return QSharedPointer<ReplaceTable>::create(tableFilePath(), isCaseSensitive());
+}
+
+void WidgetReplaceTableSetting::setFocusToFirstWidget()
+{
+    ui->lineEditTableFilePath->setFocus();
+}
+
+QString WidgetReplaceTableSetting::tableFilePath() const
+{
+    return ui->lineEditTableFilePath->text();
+}
+
+bool WidgetReplaceTableSetting::isCaseSensitive() const
+{
+    return ui->checkBoxCaseSensitive->isChecked();
+}
+
+void WidgetReplaceTableSetting::onToolButtonBrowseClicked()
+{
+    const QString filePath = QFileDialog::getOpenFileName(
+                                 this, tr("Open Replace Table"),
+                                 QFileInfo(tableFilePath()).absolutePath(),
+                                 tr("Replace Table (*.csv *.tsv *.tab *.txt);;All Files (*)"));
+
+    if (!filePath.isEmpty())
+        ui->lineEditTableFilePath->setText(filePath);
+}
+
+} // StringBuilder
@@ -19,11 +19,20 @@
 
 #include "threadcreatenewnames.h"
 
+#include "filehash/duplicatefinder.h"
+#include "filehash/filehashservice.h"
+#include "imagehash/imageclusterfinder.h"
+#include "imagehash/imagehashservice.h"
+#include "path/inodegroups.h"
 #include "path/pathroot.h"
 #include "path/pathentity.h"
 #include "path/pathentityinfo.h"
 #include "stringbuilder/onfile/builderchainonfile.h"
 
+#include <QScopeGuard>
+
+#include <optional>
+
 ThreadCreateNewNames::ThreadCreateNewNames(QWeakPointer<Path::PathRoot> pathRoot, QObject *parent)
     : QThread{parent},
       m_pathRoot{pathRoot}
@@ -47,6 +56,12 @@ void ThreadCreateNewNames::stop()
 //    qInfo() << tr("Thread for creating new name got request to stop.");
 
     m_isStopRequested = true;
+
+    if (m_fileHashService != nullptr)
+        m_fileHashService->cancel();
+
+    if (m_imageHashService != nullptr)
+        m_imageHashService->cancel();
 }
 
 void ThreadCreateNewNames::run()
@@ -130,9 +145,101 @@ bool ThreadCreateNewNames::checkNewNames(HashToCheckEntities &hashToCheckNames)
 bool ThreadCreateNewNames::createNewNames(HashToCheckEntities &hashToCheckNames)
 {
     QSharedPointer<Path::PathRoot> root = m_pathRoot.lock();
+    EntityList entities;
+
+    entities.reserve(root->entityCount());
+
+    for (qsizetype i = 0, count = root->entityCount(); i < count; ++i)
+        entities << root->entity(i);
+
+    m_lock.lockForRead();
+    const bool isFileContentNeeded = m_builderChain->isFileContentNeeded();
+    const bool isDuplicateGroupNeeded = m_builderChain->isDuplicateGroupNeeded();
+    const QList<std::pair<PerceptualHash::Algorithm, int>> imageClusterings =
+            m_builderChain->imageClusterings();
+    m_lock.unlock();
+
+    // hard links and duplicate registrations are hashed once
+    std::optional<Path::InodeGroups> inodeGroups;
+
+    if (isFileContentNeeded)
+        inodeGroups.emplace(entities);
+
+    // decodes images and reads their headers in the background, also while the duplicates
+    // are searched
+    QSharedPointer<ImageHashService> imageHashService =
+            startImageHashService(entities, inodeGroups.has_value() ? &*inodeGroups : nullptr);
+
+    auto releaseImageHashService = qScopeGuard([this]() {
+        QWriteLocker locker(&m_lock);
+
+        m_imageHashService.reset();
+    });
+
+    // before the hash service, which then reuses the full hashes of the finder
+    if (isDuplicateGroupNeeded) {
+        DuplicateFinder finder(entities, inodeGroups.has_value() ? &*inodeGroups : nullptr);
+        const QList<int> groups = finder.find([this]() { return isStopRequested(); });
+
+        if (isStopRequested())
+            return false;
+
+        for (qsizetype i = 0, count = entities.size(); i < count; ++i)
+            entities.at(i)->setDuplicateGroup(groups.at(i));
+    }
+
+    if (!imageClusterings.isEmpty()) {
+        // clustering needs every hash
+        for (qsizetype i = 0, count = entities.size(); i < count; ++i) {
+            imageHashService->waitForEntity(i);
+
+            if (isStopRequested())
+                return false;
+
+            if (inodeGroups.has_value() && !inodeGroups->isLeader(i))
+                entities.at(i)->shareContentResults(*entities.at(inodeGroups->leaderOf(i)));
+        }
+
+        // once for each distinct clustering, which every ImageGroup builder of it reads
+        for (const auto &[algorithm, threshold] : imageClusterings) {
+            ImageClusterFinder finder(entities, algorithm, threshold);
+            const QList<ImageClusterFinder::Cluster> clusters =
+                    finder.find([this]() { return isStopRequested(); });
+
+            if (isStopRequested())
+                return false;
+
+            for (qsizetype i = 0, count = entities.size(); i < count; ++i) {
+                entities.at(i)->setImageGroup(algorithm, threshold, clusters.at(i).id,
+                                              clusters.at(i).member);
+            }
+        }
+    }
+
+    QSharedPointer<FileHashService> fileHashService =
+            startFileHashService(entities, inodeGroups.has_value() ? &*inodeGroups : nullptr);
+
+    auto releaseFileHashService = qScopeGuard([this]() {
+        QWriteLocker locker(&m_lock);
+
+        m_fileHashService.reset();
+    });
 
-    for (int i = 0, count = int(root->entityCount()); i < count; ++i) {
-        createOneNewName({root->entity(i), i}, hashToCheckNames);
+    for (int i = 0, count = int(entities.size()); i < count; ++i) {
+        if (fileHashService != nullptr)
+            fileHashService->waitForEntity(i);
+
+        if (imageHashService != nullptr)
+            imageHashService->waitForEntity(i);
+
+        if (isStopRequested())
+            return false;
+
+        // the leader comes first, so its results are already there
+        if (inodeGroups.has_value() && !inodeGroups->isLeader(i))
+            entities.at(i)->shareContentResults(*entities.at(inodeGroups->leaderOf(i)));
+
+        createOneNewName({entities.at(i), i}, hashToCheckNames);
 
         if (isStopRequested())
             return false;
@@ -148,8 +255,11 @@ void ThreadCreateNewNames::createOneNewName(EntityToIndex entityToIndex
 
     m_lock.lockForRead();
 
-    m_builderChain->setFileInfo(QSharedPointer<Path::PathEntityInfo>::create(entity));
+    Path::PathEntityInfo fileInfo(*entity);
+
+    m_builderChain->setFileInfo(&fileInfo);
     entity->setNewName(m_builderChain->build());
+    m_builderChain->setFileInfo(nullptr);
 
     hashToCheckNames[quintptr(entity->parent().lock().get())] << entityToIndex;
 
@@ -157,3 +267,63 @@ void ThreadCreateNewNames::createOneNewName(EntityToIndex entityToIndex
 
     emit newNameCreated(entityToIndex.second);
 }
+
+QSharedPointer<FileHashService> ThreadCreateNewNames::startFileHashService(
+        const EntityList &entities, const Path::InodeGroups *inodeGroups)
+{
+    m_lock.lockForRead();
+    const QList<FileHash::Algorithm> algorithms = m_builderChain->fileHashAlgorithms();
+    m_lock.unlock();
+
+    if (algorithms.isEmpty())
+        return nullptr;
+
+    auto fileHashService = QSharedPointer<FileHashService>::create(
+                               entities, inodeGroups, algorithms,
+                               FileHashService::ioConcurrencyPerDevice(),
+                               FileHashService::isIoUringEnabled());
+
+    m_lock.lockForWrite();
+
+    m_fileHashService = fileHashService;
+
+    if (m_isStopRequested)
+        m_fileHashService->cancel();
+
+    m_lock.unlock();
+
+    fileHashService->start();
+
+    return fileHashService;
+}
+
+QSharedPointer<ImageHashService> ThreadCreateNewNames::startImageHashService(
+        const EntityList &entities, const Path::InodeGroups *inodeGroups)
+{
+    m_lock.lockForRead();
+    const QList<PerceptualHash::Algorithm> algorithms = m_builderChain->imageHashAlgorithms();
+    const bool isImageHeaderNeeded = m_builderChain->isImageHeaderNeeded();
+    m_lock.unlock();
+
+    if (algorithms.isEmpty() && !isImageHeaderNeeded)
+        return nullptr;
+
+    auto imageHashService = QSharedPointer<ImageHashService>::create(
+                                entities, inodeGroups, algorithms, isImageHeaderNeeded,
+                                ImageHashService::memoryBudget(),
+                                ImageHashService::isExifThumbnailEnabled(),
+                                ImageHashService::exifThumbnailCheckInterval());
+
+    m_lock.lockForWrite();
+
+    m_imageHashService = imageHashService;
+
+    if (m_isStopRequested)
+        m_imageHashService->cancel();
+
+    m_lock.unlock();
+
+    imageHashService->start();
+
+    return imageHashService;
+}
@@ -24,11 +24,17 @@
 #include <QReadWriteLock>
 #include <QWeakPointer>
 
+#include "path/usingpathentity.h"
+
 namespace Path {
+class InodeGroups;
 class PathRoot;
 class PathEntity;
 }
 
+class FileHashService;
+class ImageHashService;
+
 namespace StringBuilder{
 namespace OnFile {
 class BuilderChainOnFile;
@@ -62,10 +68,16 @@ private:
     bool checkNewNames(HashToCheckEntities &hashToCheckNames);
     bool createNewNames(HashToCheckEntities &hashToCheckNames);
     void createOneNewName(EntityToIndex entityToIndex, HashToCheckEntities &hashToCheckNames);
+    QSharedPointer<FileHashService> startFileHashService(const EntityList &entities,
+                                                         const Path::InodeGroups *inodeGroups);
+    QSharedPointer<ImageHashService> startImageHashService(const EntityList &entities,
+                                                           const Path::InodeGroups *inodeGroups);
 
     mutable QReadWriteLock m_lock;
 
     bool m_isStopRequested = false;
     QWeakPointer<Path::PathRoot> m_pathRoot;
     QSharedPointer<StringBuilder::OnFile::BuilderChainOnFile> m_builderChain;
+    QSharedPointer<FileHashService> m_fileHashService;
+    QSharedPointer<ImageHashService> m_imageHashService;
 };
@@ -19,10 +19,32 @@
 
 #include "threadrename.h"
 
+#include "application.h"
+#include "path/parentdir.h"
 #include "path/pathroot.h"
 #include "path/pathentity.h"
+#include "path/renameplanner.h"
 
 #include <QDebug>
+#include <QScopeGuard>
+#include <QHash>
+#include <QSettings>
+
+namespace {
+
+namespace Settings {
+constexpr char groupName[] = "Rename";
+constexpr char keyDirectoryConcurrency[] = "DirectoryConcurrency";
+} // Settings
+
+constexpr int defaultDirectoryConcurrency = 1;
+
+int depth(const QSharedPointer<Path::PathEntity> &entity)
+{
+    return int(entity->fullPath().count('/'));
+}
+
+} // anonymous
 
 ThreadRename::ThreadRename(QWeakPointer<Path::PathRoot> pathRoot, QObject *parent)
     : QThread{parent},
@@ -48,11 +70,16 @@ void ThreadRename::run()
     m_isStopRequested = false;
     m_lock.unlock();
 
+    m_threadPool.setMaxThreadCount(directoryConcurrency());
+
     QList<EntityToIndex> dirs;
     QList<EntityToIndex> files;
 
     QSharedPointer<Path::PathRoot> root = m_pathRoot.lock();
 
+    // directories stay open only for one run; they may be renamed or removed afterwards
+    auto releaseDirHandles = qScopeGuard([&root]() { root->releaseDirHandles(); });
+
     for (qsizetype i = 0, count = root->entityCount(); i < count; ++i) {
         QSharedPointer<Path::PathEntity> entity = root->entity(i);
 
@@ -68,14 +95,26 @@ void ThreadRename::run()
     }
 
     std::sort(dirs.begin(), dirs.end(), [](const EntityToIndex &lhs, const EntityToIndex &rhs) {
-        return lhs.first->fullPath().count('/') > rhs.first->fullPath().count('/');
+        return depth(lhs.first) > depth(rhs.first);
     });
 
-    renameEntities(dirs);
+    // directories of the same depth do not contain each other, so only the depths
+    // have to be renamed one after another.
+    for (qsizetype begin = 0, count = dirs.size(); begin < count;) {
+        const int levelDepth = depth(dirs.at(begin).first);
+        qsizetype end = begin + 1;
 
-    if (isStopRequested()) {
-        emit stopped();
-        return;
+        while (end < count && depth(dirs.at(end).first) == levelDepth)
+            ++end;
+
+        renameEntities(dirs.sliced(begin, end - begin));
+
+        if (isStopRequested()) {
+            emit stopped();
+            return;
+        }
+
+        begin = end;
     }
 
     qInfo() << tr("Finished renaming.");
@@ -90,9 +129,73 @@ bool ThreadRename::isStopRequested() const
     return m_isStopRequested;
 }
 
+int ThreadRename::directoryConcurrency()
+{
+    QSharedPointer<QSettings> qSet = Application::mainQSettings();
+
+    qSet->beginGroup(Settings::groupName);
+
+    const int concurrency = qSet->value(Settings::keyDirectoryConcurrency,
+                                       defaultDirectoryConcurrency).toInt();
+
+    qSet->endGroup();
+
+    return qMax(1, concurrency);
+}
+
 void ThreadRename::renameEntities(const QList<EntityToIndex> &entityToIndexList)
 {
+    if (m_threadPool.maxThreadCount() <= 1) {
+        renameInOrder(entityToIndexList);
+        return;
+    }
+
+    // one list per parent directory, in the order of the entities
+    QHash<Path::ParentDir *, qsizetype> dirToGroup;
+    QList<QList<EntityToIndex>> groups;
+
     for (const EntityToIndex &entityToIndex : entityToIndexList) {
+        Path::ParentDir *parent = entityToIndex.first->parent().toStrongRef().get();
+        auto it = dirToGroup.find(parent);
+
+        if (it == dirToGroup.end()) {
+            it = dirToGroup.insert(parent, groups.size());
+            groups.append(QList<EntityToIndex>{});
+        }
+
+        groups[it.value()].append(entityToIndex);
+    }
+
+    if (groups.size() == 1) {
+        renameInOrder(groups.first());
+        return;
+    }
+
+    for (const QList<EntityToIndex> &group : groups)
+        m_threadPool.start([this, group]() { renameInOrder(group); });
+
+    // renamed() of the workers is queued to the receivers like that of this thread
+    m_threadPool.waitForDone();
+}
+
+void ThreadRename::renameInOrder(const QList<EntityToIndex> &entityToIndexList)
+{
+    // entities to rename are ordered so that swapped and rotated names do not collide.
+    // the others only have their state checked.
+    QList<qsizetype> planned;
+    QList<QString> sources;
+    QList<QString> targets;
+
+    for (qsizetype i = 0, count = entityToIndexList.size(); i < count; ++i) {
+        const EntityToIndex &entityToIndex = entityToIndexList.at(i);
+
+        if (entityToIndex.first->isReadyToRename()) {
+            planned.append(i);
+            sources.append(entityToIndex.first->fullPath());
+            targets.append(entityToIndex.first->parentPath() + entityToIndex.first->newName());
+            continue;
+        }
+
         entityToIndex.first->rename();
 
         emit renamed(entityToIndex.second);
@@ -100,4 +203,28 @@ void ThreadRename::renameEntities(const QList<EntityToIndex> &entityToIndexList)
         if (isStopRequested())
             return;
     }
+
+    const Path::RenamePlanner planner(sources, targets);
+    bool isInCycle = false;
+
+    for (const Path::RenamePlanner::Step &step : planner.steps()) {
+        const EntityToIndex &entityToIndex = entityToIndexList.at(planned.at(step.index));
+
+        if (step.kind == Path::RenamePlanner::StepKind::ToTemporary) {
+            entityToIndex.first->moveAside();
+            isInCycle = true;
+            continue;
+        }
+
+        entityToIndex.first->rename();
+
+        emit renamed(entityToIndex.second);
+
+        if (step.kind == Path::RenamePlanner::StepKind::FromTemporary)
+            isInCycle = false;
+
+        // a started cycle is finished, so that nothing is left under a temporary name
+        if (!isInCycle && isStopRequested())
+            return;
+    }
 }
@@ -22,6 +22,7 @@
 #include <QThread>
 
 #include <QReadWriteLock>
+#include <QThreadPool>
 #include <QWeakPointer>
 
 namespace Path {
@@ -29,6 +30,10 @@ class PathRoot;
 class PathEntity;
 }
 
+// Renames files first, then directories from the deepest. With a directory concurrency
+// above 1, the entities of different parent directories are renamed at the same time,
+// which hides the latency of network and FUSE file systems. The entities of one
+// directory are always renamed in order by one worker.
 class ThreadRename : public QThread
 {
     Q_OBJECT
@@ -37,6 +42,8 @@ public:
 
     void stop();
 
+    static int directoryConcurrency(); // 1 renames everything in order
+
 signals:
     void renamed(int index);
     void completed();
@@ -52,8 +59,10 @@ private:
     using EntityToIndex = QPair<EntityPtr, int>;
 
     void renameEntities(const QList<EntityToIndex> &entityToIndexList);
+    void renameInOrder(const QList<EntityToIndex> &entityToIndexList);
 
     mutable QReadWriteLock m_lock;
+    QThreadPool m_threadPool;
 
     bool m_isStopRequested = false;
     QWeakPointer<Path::PathRoot> m_pathRoot;
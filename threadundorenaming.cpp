@@ -21,8 +21,19 @@
 
 #include "path/pathroot.h"
 #include "path/pathentity.h"
+#include "path/renameplanner.h"
 
 #include <QDebug>
+#include <QScopeGuard>
+
+namespace {
+
+int depth(const QSharedPointer<Path::PathEntity> &entity)
+{
+    return int(entity->fullPath().count('/'));
+}
+
+} // anonymous
 
 ThreadUndoRenaming::ThreadUndoRenaming(QWeakPointer<Path::PathRoot> pathRoot, QObject *parent)
     : QThread{parent},
@@ -53,6 +64,9 @@ void ThreadUndoRenaming::run()
 
     QSharedPointer<Path::PathRoot> root = m_pathRoot.lock();
 
+    // directories stay open only for one run; they may be renamed or removed afterwards
+    auto releaseDirHandles = qScopeGuard([&root]() { root->releaseDirHandles(); });
+
     for (qsizetype i = 0, count = root->entityCount(); i < count; ++i) {
         QSharedPointer<Path::PathEntity> entity = root->entity(i);
 
@@ -61,14 +75,25 @@ void ThreadUndoRenaming::run()
     }
 
     std::sort(dirs.begin(), dirs.end(), [](const EntityToIndex &lhs, const EntityToIndex &rhs) {
-        return lhs.first->fullPath().count('/') < rhs.first->fullPath().count('/');
+        return depth(lhs.first) < depth(rhs.first);
     });
 
-    renameEntities(dirs);
+    // a directory is back under its name before the directories in it are undone
+    for (qsizetype begin = 0, count = dirs.size(); begin < count;) {
+        const int levelDepth = depth(dirs.at(begin).first);
+        qsizetype end = begin + 1;
 
-    if (isStopRequested()) {
-        emit stopped();
-        return;
+        while (end < count && depth(dirs.at(end).first) == levelDepth)
+            ++end;
+
+        renameEntities(dirs.sliced(begin, end - begin));
+
+        if (isStopRequested()) {
+            emit stopped();
+            return;
+        }
+
+        begin = end;
     }
 
     renameEntities(files);
@@ -92,7 +117,22 @@ bool ThreadUndoRenaming::isStopRequested() const
 
 void ThreadUndoRenaming::renameEntities(const QList<EntityToIndex> &entityToIndexList)
 {
-    for (const EntityToIndex &entityToIndex : entityToIndexList) {
+    // renamed entities go back in an order where swapped and rotated names do not collide.
+    // the others only have their state reset.
+    QList<qsizetype> planned;
+    QList<QString> sources;
+    QList<QString> targets;
+
+    for (qsizetype i = 0, count = entityToIndexList.size(); i < count; ++i) {
+        const EntityToIndex &entityToIndex = entityToIndexList.at(i);
+
+        if (entityToIndex.first->isRenamed()) {
+            planned.append(i);
+            sources.append(entityToIndex.first->parentPath() + entityToIndex.first->newName());
+            targets.append(entityToIndex.first->fullPath());
+            continue;
+        }
+
         entityToIndex.first->undoRename();
 
         emit renamed(entityToIndex.second);
@@ -100,4 +140,28 @@ void ThreadUndoRenaming::renameEntities(const QList<EntityToIndex> &entityToInde
         if (isStopRequested())
             return;
     }
+
+    const Path::RenamePlanner planner(sources, targets);
+    bool isInCycle = false;
+
+    for (const Path::RenamePlanner::Step &step : planner.steps()) {
+        const EntityToIndex &entityToIndex = entityToIndexList.at(planned.at(step.index));
+
+        if (step.kind == Path::RenamePlanner::StepKind::ToTemporary) {
+            entityToIndex.first->moveAside();
+            isInCycle = true;
+            continue;
+        }
+
+        entityToIndex.first->undoRename();
+
+        emit renamed(entityToIndex.second);
+
+        if (step.kind == Path::RenamePlanner::StepKind::FromTemporary)
+            isInCycle = false;
+
+        // a started cycle is finished, so that nothing is left under a temporary name
+        if (!isInCycle && isStopRequested())
+            return;
+    }
 }
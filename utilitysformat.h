@@ -0,0 +1,105 @@
+/*
+ * Copyright YEAR Takashi Inoue
+ *
+ * This file is part of APPNAME.
+ *
+ * APPNAME is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * APPNAME is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with APPNAME.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QByteArrayView>
+#include <QString>
+
+#include <array>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace Format {
+
+using DecimalBuffer = std::array<char16_t, 64>;
+
+// Same text as QString::arg(value, width, 10, u'0') without any allocation.
+// The returned view points into buffer.
+inline QStringView decimal(int value, int width, DecimalBuffer &buffer)
+{
+    const bool isNegative = value < 0;
+    quint32 magnitude = isNegative ? 0u - quint32(value) : quint32(value);
+    qsizetype first = qsizetype(buffer.size());
+
+    do {
+        buffer[--first] = char16_t(u'0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    const qsizetype paddedFirst = qsizetype(buffer.size())
+                                  - qBound<qsizetype>(0, width, qsizetype(buffer.size()))
+                                  + (isNegative ? 1 : 0);
+
+    while (first > paddedFirst)
+        buffer[--first] = u'0';
+
+    if (isNegative)
+        buffer[--first] = u'-';
+
+    return QStringView{buffer.data() + first, qsizetype(buffer.size()) - first};
+}
+
+using HexBuffer = std::array<char16_t, 128>;
+
+// Lower case hex of at most 64 bytes without any allocation.
+// The returned view points into buffer.
+inline QStringView hex(QByteArrayView bytes, HexBuffer &buffer)
+{
+    static constexpr char16_t digits[] = u"0123456789abcdef";
+
+    Q_ASSERT(bytes.size() * 2 <= qsizetype(buffer.size()));
+
+    auto in = reinterpret_cast<const uchar *>(bytes.data());
+    char16_t *out = buffer.data();
+    qsizetype size = bytes.size();
+
+#ifdef __SSE2__
+    // 8 bytes to 16 UTF-16 units per step.
+    const __m128i lowMask = _mm_set1_epi8(0x0f);
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i letterOffset = _mm_set1_epi8('a' - '0' - 10);
+
+    for (; size >= 8; size -= 8, in += 8, out += 16) {
+        const __m128i input = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(input, 4), lowMask);
+        const __m128i low = _mm_and_si128(input, lowMask);
+        const __m128i nibbles = _mm_unpacklo_epi8(high, low);
+        const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, nine), letterOffset);
+        const __m128i chars = _mm_add_epi8(_mm_add_epi8(nibbles, zeroChar), letters);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out),
+                         _mm_unpacklo_epi8(chars, _mm_setzero_si128()));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8),
+                         _mm_unpackhi_epi8(chars, _mm_setzero_si128()));
+    }
+#endif
+
+    for (; size > 0; --size, ++in) {
+        *out++ = digits[*in >> 4];
+        *out++ = digits[*in & 0x0f];
+    }
+
+    return QStringView{buffer.data(), bytes.size() * 2};
+}
+
+} // Format
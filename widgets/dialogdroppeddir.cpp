@@ -33,6 +33,7 @@ constexpr char settingsKeyFilterHistory[] = "FilterHistory";
 constexpr char settingsKeyHierarchy[] = "Hierarchy";
 constexpr char settingsKeySearchDirs[] = "SearchDirs";
 constexpr char settingsKeySearchFiles[] = "SearchFiles";
+constexpr char settingsKeyCollapseSameInode[] = "CollapseSameInode";
 }
 
 DialogDroppedDir::DialogDroppedDir(const QList<ParentChildrenPair> &dirs, QWidget *parent)
@@ -86,7 +87,8 @@ void DialogDroppedDir::onPushButtonOkClicked()
         ui->checkBoxDirs->isChecked(),
         ui->checkBoxFiles->isChecked(),
         ui->spinBoxHierarchy->value(),
-        fixFiltersString(ui->comboBoxFilter->currentText()).split(';', Qt::SkipEmptyParts)
+        fixFiltersString(ui->comboBoxFilter->currentText()).split(';', Qt::SkipEmptyParts),
+        ui->checkBoxCollapseSameInode->isChecked()
     };
 
     SearchInDirs searchInDirs(searchSettings);
@@ -110,7 +112,16 @@ QString DialogDroppedDir::fixFiltersString(QStringView filtersString) const
     return filters.join(';');
 }
 
-QString DialogDroppedDir::iniFilePath() const
+bool DialogDroppedDir::isCollapseSameInode()
+{
+    QSettings qSettings(iniFilePath(), QSettings::IniFormat);
+
+    return qSettings.value(QStringLiteral("%1/%2").arg(settingsGroupName,
+                                                       settingsKeyCollapseSameInode),
+                           false).toBool();
+}
+
+QString DialogDroppedDir::iniFilePath()
 {
     return QApplication::applicationDirPath() + "/search.ini";
 }
@@ -130,6 +141,8 @@ void DialogDroppedDir::loadSettings()
     ui->checkBoxFiles->setChecked(qSettings.value(settingsKeySearchFiles, true).toBool());
     ui->comboBoxFilter->setCurrentText(qSettings.value(settingsKeyFilter).toString());
     ui->spinBoxHierarchy->setValue(qSettings.value(settingsKeyHierarchy, 0).toInt());
+    ui->checkBoxCollapseSameInode->setChecked(
+                qSettings.value(settingsKeyCollapseSameInode, false).toBool());
 
     qSettings.endGroup();
 }
@@ -148,6 +161,7 @@ void DialogDroppedDir::saveSettings() const
     qSettings.setValue(settingsKeySearchFiles, ui->checkBoxFiles->isChecked());
     qSettings.setValue(settingsKeyFilter, filtersString);
     qSettings.setValue(settingsKeyHierarchy, ui->spinBoxHierarchy->value());
+    qSettings.setValue(settingsKeyCollapseSameInode, ui->checkBoxCollapseSameInode->isChecked());
 
     QStringList filtersList;
 
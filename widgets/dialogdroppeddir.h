@@ -37,12 +37,14 @@ public:
     QList<ParentChildrenPair> dirsToRename() const;
     QList<ParentChildrenPair> filesToRename() const;
 
+    static bool isCollapseSameInode();
+
 private slots:
     void onPushButtonOkClicked();
 
 private:
     QString fixFiltersString(QStringView filtersString) const;
-    QString iniFilePath() const;
+    static QString iniFilePath();
     void loadSettings();
     void saveSettings() const;
 
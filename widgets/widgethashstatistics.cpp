@@ -0,0 +1,119 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "widgethashstatistics.h"
+#include "ui_widgethashstatistics.h"
+
+#include "filehash/filehashstatistics.h"
+
+#include <QFile>
+#include <QFileDialog>
+#include <QJsonDocument>
+#include <QLocale>
+#include <QMessageBox>
+
+namespace {
+constexpr int refreshIntervalMs = 500;
+
+QString toMilliseconds(qint64 nanoseconds)
+{
+    return QStringLiteral("%1 ms").arg(double(nanoseconds) / 1e6, 0, 'f', 1);
+}
+
+} // anonymous
+
+WidgetHashStatistics::WidgetHashStatistics(QWidget *parent) :
+    QWidget{parent},
+    ui{new Ui::WidgetHashStatistics}
+{
+    ui->setupUi(this);
+
+    connect(&m_refreshTimer, &QTimer::timeout, this, &WidgetHashStatistics::refresh);
+    connect(ui->pushButtonReset, &QPushButton::clicked,
+            this, &WidgetHashStatistics::onPushButtonResetClicked);
+    connect(ui->pushButtonSaveJson, &QPushButton::clicked,
+            this, &WidgetHashStatistics::onPushButtonSaveJsonClicked);
+
+    m_refreshTimer.start(refreshIntervalMs);
+
+    refresh();
+}
+
+WidgetHashStatistics::~WidgetHashStatistics()
+{
+    delete ui;
+}
+
+void WidgetHashStatistics::refresh()
+{
+    if (!isVisible())
+        return;
+
+    const FileHashStatistics::Snapshot snapshot = FileHashStatistics::instance().snapshot();
+    const QLocale locale;
+
+    ui->labelBytesRead->setText(locale.formattedDataSize(snapshot.bytesRead));
+    ui->labelFilesHashed->setText(locale.toString(snapshot.filesHashed));
+
+    // per stream. concurrent files overlap, so this is the speed one reader sees.
+    const double seconds = double(snapshot.wallTimeNs) / 1e9;
+
+    ui->labelThroughput->setText(seconds > 0
+                                 ? QStringLiteral("%1/s").arg(locale.formattedDataSize(
+                                                                  qint64(snapshot.bytesRead / seconds)))
+                                 : QStringLiteral("-"));
+
+    QStringList cpuTimes;
+
+    for (auto itr = snapshot.cpuTimeNs.cbegin(), end = snapshot.cpuTimeNs.cend(); itr != end; ++itr)
+        cpuTimes << QStringLiteral("%1: %2").arg(FileHash::algorithmName(itr.key()), toMilliseconds(itr.value()));
+
+    cpuTimes.sort();
+
+    ui->labelCpuTime->setText(cpuTimes.isEmpty() ? QStringLiteral("-") : cpuTimes.join('\n'));
+    ui->labelQueueDepth->setText(QStringLiteral("%1 (max %2)").arg(snapshot.queueDepth)
+                                                              .arg(snapshot.maxQueueDepth));
+    ui->labelLatency->setText(QStringLiteral("p50 %1 / p99 %2").arg(toMilliseconds(snapshot.latencyP50Ns),
+                                                                    toMilliseconds(snapshot.latencyP99Ns)));
+}
+
+void WidgetHashStatistics::onPushButtonResetClicked()
+{
+    FileHashStatistics::instance().reset();
+
+    refresh();
+}
+
+void WidgetHashStatistics::onPushButtonSaveJsonClicked()
+{
+    const QString filePath = QFileDialog::getSaveFileName(
+                                 this, tr("Save Hash Statistics"), QString{},
+                                 tr("JSON (*.json);;All Files (*)"));
+
+    if (filePath.isEmpty())
+        return;
+
+    const FileHashStatistics::Snapshot snapshot = FileHashStatistics::instance().snapshot();
+    QFile file(filePath);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || file.write(QJsonDocument(FileHashStatistics::toJson(snapshot)).toJson()) < 0) {
+        QMessageBox::warning(this, tr("Save Hash Statistics"),
+                             tr("Failed to save \"%1\".\n%2").arg(filePath, file.errorString()));
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright 2021 Takashi Inoue
+ *
+ * This file is part of FileRenamer.
+ *
+ * FileRenamer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * FileRenamer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with FileRenamer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <QTimer>
+#include <QWidget>
+
+namespace Ui {
+class WidgetHashStatistics;
+}
+
+class WidgetHashStatistics : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit WidgetHashStatistics(QWidget *parent = nullptr);
+    ~WidgetHashStatistics() override;
+
+private slots:
+    void refresh();
+    void onPushButtonResetClicked();
+    void onPushButtonSaveJsonClicked();
+
+private:
+    Ui::WidgetHashStatistics *ui;
+    QTimer m_refreshTimer;
+};